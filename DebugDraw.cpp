@@ -0,0 +1,116 @@
+#include "DebugDraw.h"
+
+#ifdef _DEBUG
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	const float PI = 3.14159265f;
+}
+
+////////////////////////////////////////////////////////////
+void DebugDraw::drawLine(sf::Vector2f t_start, sf::Vector2f t_end, sf::Color t_color, float t_thickness)
+{
+	m_arrows.addArrow(t_start, t_end - t_start, t_color, t_thickness, thor::Arrow::Line);
+}
+
+////////////////////////////////////////////////////////////
+void DebugDraw::drawArrow(sf::Vector2f t_position, sf::Vector2f t_direction, sf::Color t_color, float t_thickness)
+{
+	m_arrows.addArrow(t_position, t_direction, t_color, t_thickness, thor::Arrow::Forward);
+}
+
+////////////////////////////////////////////////////////////
+void DebugDraw::drawCone(sf::Vector2f t_apex, sf::Vector2f t_direction, float t_halfAngle, float t_length, sf::Color t_color,
+	float t_thickness)
+{
+	// Same rotation as thor::rotatedVector(): positive angles turn clockwise on screen.
+	float axisAngle = std::atan2(t_direction.y, t_direction.x);
+	float halfAngle = t_halfAngle * PI / 180.0f;
+	float leftAngle = axisAngle - halfAngle;
+	float rightAngle = axisAngle + halfAngle;
+
+	drawLine(t_apex, t_apex + t_length * sf::Vector2f(std::cos(leftAngle), std::sin(leftAngle)), t_color, t_thickness);
+	drawLine(t_apex, t_apex + t_length * sf::Vector2f(std::cos(rightAngle), std::sin(rightAngle)), t_color, t_thickness);
+	addArc(t_apex, t_length, leftAngle, rightAngle, t_color, t_thickness);
+}
+
+////////////////////////////////////////////////////////////
+void DebugDraw::drawCircle(sf::Vector2f t_center, float t_radius, sf::Color t_color, float t_thickness)
+{
+	addArc(t_center, t_radius, 0.0f, 2.0f * PI, t_color, t_thickness);
+}
+
+////////////////////////////////////////////////////////////
+void DebugDraw::clear()
+{
+	m_arrows.clear();
+	m_vertices.clear();
+}
+
+////////////////////////////////////////////////////////////
+void DebugDraw::record(RenderCommandBuffer& t_commands, RenderLayer t_layer) const
+{
+	std::size_t count = getVertexCount();
+	if (count == 0)
+	{
+		return;
+	}
+
+	// Both parts go into one block, so the overlay is a single draw.
+	const sf::VertexArray& arrowVertices = m_arrows.getVertices();
+	sf::Vertex* vertices = t_commands.allocateVertices(count);
+	for (std::size_t i = 0; i < arrowVertices.getVertexCount(); ++i)
+	{
+		vertices[i] = arrowVertices[i];
+	}
+	std::copy(m_vertices.begin(), m_vertices.end(), vertices + arrowVertices.getVertexCount());
+	t_commands.draw(t_layer, vertices, count, sf::Triangles, nullptr);
+}
+
+////////////////////////////////////////////////////////////
+std::size_t DebugDraw::getVertexCount() const
+{
+	return m_arrows.getVertices().getVertexCount() + m_vertices.size();
+}
+
+////////////////////////////////////////////////////////////
+void DebugDraw::addArc(sf::Vector2f t_center, float t_radius, float t_startAngle, float t_endAngle, sf::Color t_color,
+	float t_thickness)
+{
+	float sweep = t_endAngle - t_startAngle;
+	std::size_t segments = std::max<std::size_t>(1,
+		static_cast<std::size_t>(std::ceil(std::abs(sweep) / (2.0f * PI) * CIRCLE_SEGMENTS)));
+
+	// Consecutive segments share their end points, so the band has no gaps.
+	float inner = std::max(t_radius - t_thickness / 2.0f, 0.0f);
+	float outer = t_radius + t_thickness / 2.0f;
+	sf::Vector2f unit(std::cos(t_startAngle), std::sin(t_startAngle));
+	sf::Vector2f previousInner = t_center + inner * unit;
+	sf::Vector2f previousOuter = t_center + outer * unit;
+
+	std::size_t first = m_vertices.size();
+	m_vertices.resize(first + 6 * segments);
+	sf::Vertex* vertices = &m_vertices[first];
+	for (std::size_t i = 1; i <= segments; ++i)
+	{
+		float angle = t_startAngle + sweep * i / segments;
+		unit = sf::Vector2f(std::cos(angle), std::sin(angle));
+		sf::Vector2f currentInner = t_center + inner * unit;
+		sf::Vector2f currentOuter = t_center + outer * unit;
+
+		*vertices++ = sf::Vertex(previousInner, t_color);
+		*vertices++ = sf::Vertex(previousOuter, t_color);
+		*vertices++ = sf::Vertex(currentOuter, t_color);
+		*vertices++ = sf::Vertex(previousInner, t_color);
+		*vertices++ = sf::Vertex(currentOuter, t_color);
+		*vertices++ = sf::Vertex(currentInner, t_color);
+
+		previousInner = currentInner;
+		previousOuter = currentOuter;
+	}
+}
+
+#endif
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include <cstddef>
+
+#include "RenderCommandBuffer.h"
+
+#ifdef _DEBUG
+#include <Thor/Shapes/ArrowBatch.hpp>
+
+#include <vector>
+#endif
+
+/// <summary>
+/// @brief Immediate mode debug overlay for lines, arrows, cones and circles.
+///
+/// Shapes are not objects: each call appends triangles to a transient vertex buffer,
+///  and record() draws the whole buffer with a single draw command. Shapes are drawn
+///  again every update step, so the buffer is cleared at the start of each step and
+///  always shows the last one, however many steps a frame takes.
+/// In release builds (without _DEBUG) every function is empty and inline and the class
+///  has no members, so the calls compile to nothing. Debug-only queries that are costly
+///  by themselves can be skipped with DebugDraw::ENABLED.
+/// Example usage:
+///		m_debugDraw.clear();
+///		m_debugDraw.drawLine(position, target, sf::Color::Red);
+///		...
+///		m_debugDraw.record(commands, RenderLayer::Hud);
+/// </summary>
+class DebugDraw
+{
+public:
+#ifdef _DEBUG
+	static constexpr bool ENABLED{ true };
+#else
+	static constexpr bool ENABLED{ false };
+#endif
+
+	/// <summary>
+	/// @brief Draws a line segment between two points.
+	/// </summary>
+	void drawLine(sf::Vector2f t_start, sf::Vector2f t_end, sf::Color t_color, float t_thickness = 2.0f);
+
+	/// <summary>
+	/// @brief Draws an arrow like thor::Arrow, with a triangle at the end point.
+	/// </summary>
+	/// <param name="t_position">Starting point of the arrow</param>
+	/// <param name="t_direction">The vector the arrow represents</param>
+	void drawArrow(sf::Vector2f t_position, sf::Vector2f t_direction, sf::Color t_color, float t_thickness = 2.0f);
+
+	/// <summary>
+	/// @brief Draws the outline of a circle sector: two sides and the arc between them.
+	/// </summary>
+	/// <param name="t_apex">Tip of the cone</param>
+	/// <param name="t_direction">Direction of the cone axis, need not be normalised</param>
+	/// <param name="t_halfAngle">Angle between the axis and each side, in degrees</param>
+	/// <param name="t_length">Length of the sides</param>
+	void drawCone(sf::Vector2f t_apex, sf::Vector2f t_direction, float t_halfAngle, float t_length, sf::Color t_color,
+		float t_thickness = 2.0f);
+
+	/// <summary>
+	/// @brief Draws the outline of a circle.
+	/// </summary>
+	void drawCircle(sf::Vector2f t_center, float t_radius, sf::Color t_color, float t_thickness = 2.0f);
+
+	/// <summary>
+	/// @brief Removes all shapes, keeping the capacity of the vertex buffer.
+	/// </summary>
+	void clear();
+
+	/// <summary>
+	/// @brief Records all shapes as one untextured draw. The vertices are copied into the command buffer's frame memory,
+	///  so the shapes stay until the next clear().
+	/// </summary>
+	void record(RenderCommandBuffer& t_commands, RenderLayer t_layer) const;
+
+	/// <summary>
+	/// @brief Returns the number of vertices drawn by record().
+	/// </summary>
+	std::size_t getVertexCount() const;
+
+#ifdef _DEBUG
+private:
+	// Number of segments of a full circle; arcs use a proportional number.
+	static const std::size_t CIRCLE_SEGMENTS{ 32 };
+
+	// Adds a band of the given thickness along an arc, between two angles in radians.
+	void addArc(sf::Vector2f t_center, float t_radius, float t_startAngle, float t_endAngle, sf::Color t_color,
+		float t_thickness);
+
+	// Lines and arrows share the meshes of the arrow batch.
+	thor::ArrowBatch m_arrows;
+	// Circles and arcs, as triangles.
+	std::vector<sf::Vertex> m_vertices;
+#endif
+};
+
+#ifndef _DEBUG
+inline void DebugDraw::drawLine(sf::Vector2f, sf::Vector2f, sf::Color, float) {}
+inline void DebugDraw::drawArrow(sf::Vector2f, sf::Vector2f, sf::Color, float) {}
+inline void DebugDraw::drawCone(sf::Vector2f, sf::Vector2f, float, float, sf::Color, float) {}
+inline void DebugDraw::drawCircle(sf::Vector2f, float, sf::Color, float) {}
+inline void DebugDraw::clear() {}
+inline void DebugDraw::record(RenderCommandBuffer&, RenderLayer) const {}
+inline std::size_t DebugDraw::getVertexCount() const { return 0; }
+#endif
@@ -1,30 +1,27 @@
 ﻿#include "Game.h"
 #include <iostream>
 
+#include <Thor/Math/Predicates.hpp>
+
 // Updates per milliseconds
 static double const MS_PER_UPDATE = 10.0;
 
+constexpr const char* Game::SPRITE_SHEET;
+constexpr const char* Game::TIMING_BAR;
+constexpr const char* Game::SMOKE;
+constexpr const char* Game::WHITE;
+
 ////////////////////////////////////////////////////////////
 Game::Game()
 	: m_window(sf::VideoMode(ScreenSize::s_width, ScreenSize::s_height, 32), "SFML Playground", sf::Style::Default)
+	, m_timerWheel(m_simulationClock, sf::milliseconds(static_cast<sf::Int32>(MS_PER_UPDATE)))
 {
 	m_window.setVerticalSyncEnabled(true);
 
-	//loads in the sprite sheet	
-	if (!m_spriteSheetTexture.loadFromFile("./resources/assets/graphics/SpriteSheet.png"))
-	{
-		std::string s("Error loading texture");
-		throw std::exception(s.c_str());
-	}
-
-	if (!m_timingBarTexture.loadFromFile("./resources/assets/graphics/TimingBar.png"))
-	{
-		std::string s("Error loading texture");
-		throw std::exception(s.c_str());
-	}
+	loadTextures();
 
 	// Initialise the particle system
-	m_particleSystem.initParticleSystem();
+	m_particleSystem.initParticleSystem(m_atlas.getTexture(), m_atlas.getRect(SMOKE));
 
 	initTankSprites();
 
@@ -34,9 +31,10 @@ Game::Game()
 
 	m_rectShape.setSize(sf::Vector2f(TIMING_BAR_WIDTH, 20));	
 	m_rectShape.setPosition(600, 30);
-	m_rectShape.setTexture(&m_timingBarTexture);
-	// Setup the timer to run for 1 second.
-	m_timer.reset(sf::Time(sf::milliseconds(TIMER_DURATION)));
+	m_rectShape.setTexture(&m_atlas.getTexture());
+	m_rectShape.setTextureRect(m_timingBarRect);
+
+	initInputBindings();
 
 	// Setup the vision cone with 30 degrees field of view.
 	setVisionCone(30.0f);
@@ -60,11 +58,12 @@ void Game::run()
 
 		while (lag > MS_PER_UPDATE)
 		{
-			update(lag);
+			sf::Time step = m_simulationClock.advance(sf::milliseconds(static_cast<sf::Int32>(MS_PER_UPDATE)));
+			update(step.asMicroseconds() / 1000.0);
 			lag -= MS_PER_UPDATE;
 		}
-		update(lag);
 
+		recordFrame();
 		render();
 	}
 }
@@ -86,41 +85,58 @@ void Game::processEvents()
 ////////////////////////////////////////////////////////////
 void Game::processGameEvents(sf::Event& event)
 {
-	// check if the event is a a mouse button release
-	if (sf::Event::KeyPressed == event.type)
+	m_inputActions.pushEvent(event);
+}
+
+////////////////////////////////////////////////////////////
+void Game::bindAction(GameAction t_action, const InputAction& t_input)
+{
+	m_inputActions.setAction(t_action, t_input);
+}
+
+////////////////////////////////////////////////////////////
+void Game::initInputBindings()
+{
+	bindAction(MOVE_UP, InputAction(sf::Keyboard::W));
+	bindAction(MOVE_DOWN, InputAction(sf::Keyboard::S));
+	bindAction(MOVE_LEFT, InputAction(sf::Keyboard::A));
+	bindAction(MOVE_RIGHT, InputAction(sf::Keyboard::D));
+	bindAction(ROTATE_LEFT, InputAction(sf::Keyboard::Left));
+	bindAction(ROTATE_RIGHT, InputAction(sf::Keyboard::Right));
+	bindAction(FIRE, InputAction(sf::Keyboard::Space, InputAction::PressOnce));
+	bindAction(RESET, InputAction(sf::Keyboard::R, InputAction::PressOnce));
+	bindAction(QUIT, InputAction(sf::Keyboard::Escape, InputAction::PressOnce));
+
+	// Held keys move at a fixed speed per simulated second, independent of the OS key repeat rate.
+	m_actionHandlers[MOVE_UP] = [this](double dt) { m_circleShape.move(0, -MOVE_SPEED * (dt / 1000)); };
+	m_actionHandlers[MOVE_DOWN] = [this](double dt) { m_circleShape.move(0, MOVE_SPEED * (dt / 1000)); };
+	m_actionHandlers[MOVE_LEFT] = [this](double dt) { m_circleShape.move(-MOVE_SPEED * (dt / 1000), 0); };
+	m_actionHandlers[MOVE_RIGHT] = [this](double dt) { m_circleShape.move(MOVE_SPEED * (dt / 1000), 0); };
+	m_actionHandlers[ROTATE_LEFT] = [this](double dt) { m_turretSprite.rotate(-ROTATION_SPEED * (dt / 1000)); };
+	m_actionHandlers[ROTATE_RIGHT] = [this](double dt) { m_turretSprite.rotate(ROTATION_SPEED * (dt / 1000)); };
+	m_actionHandlers[FIRE] = [this](double) { m_fireRequest = true; };
+	m_actionHandlers[RESET] = [this](double)
+	{
+		m_circleShape.setPosition(500, 300);
+		m_timerWheel.cancel(m_chargeTimer);
+		m_projectileReleased = false;
+	};
+	m_actionHandlers[QUIT] = [this](double) { m_window.close(); };
+}
+
+////////////////////////////////////////////////////////////
+void Game::dispatchActions(double dt)
+{
+	m_inputActions.update();
+
+	// Events only count for the first step after they arrived, held keys are sampled every step.
+	m_inputActions.clearEvents();
+
+	for (std::size_t action = 0; action < GAME_ACTION_COUNT; ++action)
 	{
-		switch (event.key.code)
+		if (m_inputActions.isActive(action) && m_actionHandlers[action])
 		{
-		case sf::Keyboard::Escape:
-			m_window.close();
-			break;
-		case sf::Keyboard::W:
-			m_circleShape.move(0, -1);
-			break;
-		case sf::Keyboard::A:
-			m_circleShape.move(-1, 0);
-			break;
-		case sf::Keyboard::S:
-			m_circleShape.move(0, 1);
-			break;
-		case sf::Keyboard::R:
-			m_circleShape.setPosition(500, 300);
-			m_timer.reset(sf::Time(sf::milliseconds(TIMER_DURATION)));
-			break;
-		case sf::Keyboard::D:
-			m_circleShape.move(1, 0);
-			break;
-		case sf::Keyboard::Right:
-			m_turretSprite.rotate(1.0f);
-			break;
-		case sf::Keyboard::Left:
-			m_turretSprite.rotate(-1.0f);
-			break;
-		case sf::Keyboard::Space:
-			m_fireRequest = true;
-			break;
-		default:
-			break;
+			m_actionHandlers[action](dt);
 		}
 	}
 }
@@ -128,6 +144,9 @@ void Game::processGameEvents(sf::Event& event)
 ////////////////////////////////////////////////////////////
 void Game::update(double dt)
 {	
+	m_debugDraw.clear();
+	dispatchActions(dt);
+
 	// Is the circle inside the vision cone
 	// Taking the perspective from the vision cone end, looking towards the tank
 	// If the circle is left of the left line and right of the right line, it is inside the cone.?
@@ -142,14 +161,25 @@ void Game::update(double dt)
 	{
 		m_circleShape.setFillColor(sf::Color::Red);
 	}
+	// Debug builds also show the query itself: the tested point and the line of sight to it.
+	sf::Color queryColor = (leftOfLeftLine && rightOfRightLine) ? sf::Color::Green : sf::Color::Red;
+	m_debugDraw.drawLine(m_visionConeLeft, m_circleShape.getPosition(), queryColor, 1.0f);
+	m_debugDraw.drawCircle(m_circleShape.getPosition(), 10.0f, queryColor, 1.0f);
 
 
 	m_particleSystem.update(dt);
+	// Follows the simulation clock, so pausing or scaling time also applies to the timers.
+	m_timerWheel.update();
+
 	// If space has been pressed (fire request)
 	if (m_fireRequest)
 	{
-		// Initiate the timer
-		m_timer.start();
+		// Initiate the charge timer, unless it is already charging or has fired.
+		if (!m_projectileReleased && !m_timerWheel.isPending(m_chargeTimer))
+		{
+			m_chargeTimer = m_timerWheel.schedule(sf::milliseconds(static_cast<sf::Int32>(TIMER_DURATION)),
+				[this] { m_projectileReleased = true; });
+		}
 	
 		double rotation = m_turretSprite.getRotation();
 		sf::Vector2f turretPos = m_turretSprite.getPosition();
@@ -182,48 +212,119 @@ void Game::update(double dt)
 	}
 	// If the timer has elapsed, start translating the circle along the 
 	//  direction vector.
-	if (m_timer.isExpired())
+	if (m_projectileReleased)
 	{
 		m_circleShape.move(m_startPoint.x * PROJECTILE_SPEED * (dt / 1000), 
 						   m_startPoint.y * PROJECTILE_SPEED * (dt / 1000));
 	}
-	else if (m_timer.isRunning())
+	else if (m_timerWheel.isPending(m_chargeTimer))
 	{
-		float timeRemainPerCent = m_timer.getRemainingTime().asMilliseconds() / TIMER_DURATION;
+		float timeRemainPerCent = m_timerWheel.getRemainingTime(m_chargeTimer).asMilliseconds() / TIMER_DURATION;
 		m_rectShape.setScale(timeRemainPerCent, 1);
 		m_rectShape.setTextureRect(
-			sf::IntRect(0, 0, m_timingBarTexture.getSize().x * timeRemainPerCent, 
-			                  m_timingBarTexture.getSize().y)
+			m_atlas.getRect(TIMING_BAR, sf::IntRect(0, 0, m_timingBarRect.width * timeRemainPerCent, 
+			                                        m_timingBarRect.height))
 		);
 	}
 }
 
+////////////////////////////////////////////////////////////
+void Game::recordFrame()
+{
+	m_renderCommands.clear();
+
+	// Everything but the particles shares the atlas texture, so this is a single draw call.
+	m_spriteBatch.draw(m_tankBaseSprite);
+	m_spriteBatch.draw(m_turretSprite);
+	m_spriteBatch.draw(m_circleShape);
+	m_spriteBatch.draw(m_rectShape);
+	m_spriteBatch.draw(m_arrowLeft);
+	m_spriteBatch.draw(m_arrowRight);
+	m_spriteBatch.record(m_renderCommands, RenderLayer::World);
+	m_particleSystem.record(m_renderCommands, RenderLayer::Effects);
+	// The debug overlay of the last update step, on top of everything.
+	m_debugDraw.record(m_renderCommands, RenderLayer::Hud);
+}
+
 ////////////////////////////////////////////////////////////
 void Game::render()
 {
 	m_window.clear(sf::Color(0, 0, 0, 0));
-	m_window.draw(m_tankBaseSprite);
-	m_window.draw(m_turretSprite);
-	m_window.draw(m_circleShape);
-	m_window.draw(m_rectShape);
-	m_window.draw(m_arrowLeft);
-	m_window.draw(m_arrowRight);
-	m_particleSystem.render(m_window);
+
+	m_renderCommands.sort();
+	m_renderBackend.submit(m_renderCommands);
+	m_drawCallCount = static_cast<unsigned>(m_renderBackend.getDrawCallCount());
+
 	m_window.display();
 }
 
+////////////////////////////////////////////////////////////
+unsigned Game::getDrawCallCount() const
+{
+	return m_drawCallCount;
+}
+
+////////////////////////////////////////////////////////////
+void Game::loadTextures()
+{
+	// Prefer the asset pack if it has been built (see tools/AssetPacker.cpp), otherwise load the loose files.
+	bool packed = m_assetPack.open("./resources/assets.pack");
+	auto imageSource = [this, packed](const std::string& t_name)
+	{
+		return packed ? thor::Resources::fromImagePack<sf::Image>(m_assetPack, t_name, m_imageCache)
+		              : thor::Resources::fromImageFile<sf::Image>("./resources/assets/" + t_name, m_imageCache);
+	};
+
+	// The images are decoded (or read from the decoded image cache) on worker threads.
+	const std::pair<const char*, const char*> sources[] =
+	{
+		{ SPRITE_SHEET, "graphics/SpriteSheet.png" },
+		{ TIMING_BAR, "graphics/TimingBar.png" },
+		{ SMOKE, "graphics/SmokeTexture.png" }
+	};
+	thor::ResourceHolder<sf::Image, std::string> images;
+	std::vector<std::future<sf::Image&>> loads;
+	for (const std::pair<const char*, const char*>& source : sources)
+	{
+		loads.push_back(images.acquireAsync(source.first, imageSource(source.second)));
+	}
+
+	images.finishAsyncLoads();
+	m_assetPack.close();
+
+	// Pack everything into one texture. get() rethrows thor::ResourceLoadingException if an image failed to load.
+	for (std::size_t i = 0; i < loads.size(); ++i)
+	{
+		m_atlas.add(sources[i].first, loads[i].get());
+	}
+	// A white area for untextured shapes, so that they can be batched with the sprites.
+	sf::Image white;
+	white.create(4, 4, sf::Color::White);
+	m_atlas.add(WHITE, white);
+	if (!m_atlas.build())
+	{
+		std::string s("Error building texture atlas");
+		throw std::exception(s.c_str());
+	}
+	m_timingBarRect = m_atlas.getRect(TIMING_BAR);
+
+	sf::IntRect whiteRect = m_atlas.getRect(WHITE);
+	m_spriteBatch.setWhitePixel(&m_atlas.getTexture(),
+		sf::Vector2f(whiteRect.left + whiteRect.width / 2.0f, whiteRect.top + whiteRect.height / 2.0f));
+}
+
 void Game::initTankSprites()
 {
 	// Initialise the tank base
-	m_tankBaseSprite.setTexture(m_spriteSheetTexture);
+	m_tankBaseSprite.setTexture(m_atlas.getTexture());
 	sf::IntRect baseRect(2, 43, 79, 43);
-	m_tankBaseSprite.setTextureRect(baseRect);
+	m_tankBaseSprite.setTextureRect(m_atlas.getRect(SPRITE_SHEET, baseRect));
 	m_tankBaseSprite.setOrigin(baseRect.width / 2.0, baseRect.height / 2.0);
 
 	// Initialise the turret
-	m_turretSprite.setTexture(m_spriteSheetTexture);
+	m_turretSprite.setTexture(m_atlas.getTexture());
 	sf::IntRect turretRect(19, 1, 83, 31);
-	m_turretSprite.setTextureRect(turretRect);
+	m_turretSprite.setTextureRect(m_atlas.getRect(SPRITE_SHEET, turretRect));
 	m_turretSprite.setOrigin(turretRect.width / 3.0, turretRect.height / 2.0);
 
 	// Set initial positions
@@ -263,17 +364,12 @@ void Game::setVisionCone(float t_angle)
 
 bool Game::isRight(sf::Vector2f t_linePoint1, sf::Vector2f t_linePoint2, sf::Vector2f t_point) const
 {
-	return (
-		(t_linePoint2.x - t_linePoint1.x) * (t_point.y - t_linePoint1.y) -
-		(t_linePoint2.y - t_linePoint1.y) * (t_point.x - t_linePoint1.x)
-		) > 0;
+	// The sign is exact, so a point on the line is neither left nor right of it.
+	return thor::orientation(t_linePoint1, t_linePoint2, t_point) > 0;
 }
 
 
 bool Game::isLeft(sf::Vector2f t_linePoint1, sf::Vector2f t_linePoint2, sf::Vector2f t_point) const
 {
-	return (
-		(t_linePoint2.x - t_linePoint1.x) * (t_point.y - t_linePoint1.y) -
-		(t_linePoint2.y - t_linePoint1.y) * (t_point.x - t_linePoint1.x)
-		) < 0;
+	return thor::orientation(t_linePoint1, t_linePoint2, t_point) < 0;
 }
\ No newline at end of file
@@ -2,11 +2,22 @@
 
 #include <SFML/Graphics.hpp>
 #include <Thor/Shapes.hpp>
+#include <Thor/Resources.hpp>
 
 #include "ScreenSize.h"
 #include "MathUtility.h"
-#include "Thor/Time.hpp"
 #include "ParticleSystem.h"
+#include "TimerWheel.h"
+#include "SimulationClock.h"
+#include "InputActionMap.h"
+#include "TextureAtlas.h"
+#include "SpriteBatch.h"
+#include "RenderCommandBuffer.h"
+#include "RenderBackend.h"
+#include "DebugDraw.h"
+
+#include <array>
+#include <functional>
 
 /// <summary>
 /// @author RP
@@ -27,6 +38,24 @@
 class Game
 {
 public:
+	/// <summary>
+	/// @brief Everything the player can do, used as ids into the input action map.
+	/// </summary>
+	enum GameAction
+	{
+		MOVE_UP,
+		MOVE_DOWN,
+		MOVE_LEFT,
+		MOVE_RIGHT,
+		ROTATE_LEFT,
+		ROTATE_RIGHT,
+		FIRE,
+		RESET,
+		QUIT,
+		GAME_ACTION_COUNT
+	};
+
+
 	/// <summary>
 	/// @brief Default constructor that initialises the SFML window, 
 	///   and sets vertical sync enabled. 
@@ -40,11 +69,25 @@ public:
 	/// The actual elapsed time for a single game loop results (lag) is stored. If this value is 
 	///  greater than the notional time for one loop (MS_PER_UPDATE), then additional updates will be 
 	///  performed until the lag is less than the notional time for one loop.
+	/// Each update advances the simulation clock by exactly one (time scaled) step.
 	/// The target is one update and one render cycle per game loop, but slower PCs may 
 	///  perform more update than render operations in one loop.
 	/// </summary>
 	void run();
 
+	/// <summary>
+	/// @brief Binds a game action to an input, replacing the previous binding.
+	/// Takes effect at the next update step, so bindings can be changed at runtime.
+	/// </summary>
+	/// <param name="t_action">The game action to rebind</param>
+	/// <param name="t_input">The input that triggers it</param>
+	void bindAction(GameAction t_action, const InputAction& t_input);
+
+	/// <summary>
+	/// @brief Returns the number of draw calls the last frame needed.
+	/// </summary>
+	unsigned getDrawCallCount() const;
+
 	bool isLeft(sf::Vector2f t_linePoint1, sf::Vector2f t_linePoint2, sf::Vector2f t_point) const;
 	bool isRight(sf::Vector2f t_linePoint1, sf::Vector2f t_linePoint2, sf::Vector2f t_point) const;
 
@@ -56,11 +99,18 @@ protected:
 	void update(double dt);
 
 	/// <summary>
-	/// @brief Draws the background and foreground game objects in the SFML window.
+	/// @brief Records the draw commands of all game objects for the next render().
+	/// Does not call into SFML, so it can run wherever the simulation runs.
+	/// </summary>
+	void recordFrame();
+
+	/// <summary>
+	/// @brief Sorts and submits the recorded draw commands to the SFML window.
 	/// The render window is always cleared to black before anything is drawn.
 	/// </summary>
 	void render();
 
+
 	/// <summary>
 	/// @brief Checks for events.
 	/// Allows window to function and exit. 
@@ -70,10 +120,27 @@ protected:
 
 	/// <summary>
 	/// @brief Handles all user input.
+	/// Events are only recorded here; the bound actions are evaluated once per update step.
 	/// </summary>
 	/// <param name="event">system event</param>
 	void processGameEvents(sf::Event&);
 
+	/// <summary>
+	/// @brief Sets up the default key bindings and the handler of every game action.
+	/// </summary>
+	void initInputBindings();
+
+	/// <summary>
+	/// @brief Samples the input once and calls the handlers of all active actions.
+	/// </summary>
+	/// <param name="dt">update delta time</param>
+	void dispatchActions(double dt);
+
+	/// <summary>
+	/// @brief Loads all images, decoding them in parallel, and packs them into the texture atlas.
+	/// </summary>
+	void loadTextures();
+
 	void initTankSprites();
 
 	/// <summary>
@@ -85,13 +152,44 @@ protected:
 	// main window
 	sf::RenderWindow m_window;
 
+	// Precompiled input bindings, indexed by GameAction.
+	InputActionMap m_inputActions;
+	// Handler of every game action, called with the update delta time while the action is active.
+	std::array<std::function<void(double)>, GAME_ACTION_COUNT> m_actionHandlers;
+
+	// Movement speeds while a move or rotate key is held.
+	static constexpr float MOVE_SPEED{ 100.0f };	// pixels per second
+	static constexpr float ROTATION_SPEED{ 90.0f };	// degrees per second
+
+	// Simulated time, advanced once per fixed update step.
+	SimulationClock m_simulationClock;
+
 	// Custom particleSystem 
 	ParticleSystem m_particleSystem;
 
-	sf::Texture m_spriteSheetTexture;
-	sf::Texture m_tankBaseTexture;
-	sf::Texture m_turretTexture;
-	sf::Texture m_timingBarTexture;
+	// Packed assets, mapped while the textures are loaded.
+	thor::AssetPack m_assetPack;
+	// Decoded pixels of the textures, so that only the first launch decompresses the images.
+	thor::DecodedImageCache m_imageCache{ "./resources/cache" };
+	// All images, packed into a single texture at startup.
+	TextureAtlas m_atlas;
+	// Names of the images in the atlas.
+	static constexpr const char* SPRITE_SHEET{ "SpriteSheet" };
+	static constexpr const char* TIMING_BAR{ "TimingBar" };
+	static constexpr const char* SMOKE{ "Smoke" };
+	static constexpr const char* WHITE{ "White" };
+	// Area of the timing bar within the atlas.
+	sf::IntRect m_timingBarRect;
+
+	// Merges the draws of the sprites, shapes and arrows.
+	SpriteBatch m_spriteBatch;
+	// Draws of the current frame, recorded by recordFrame() and submitted by render().
+	RenderCommandBuffer m_renderCommands;
+	SfmlRenderBackend m_renderBackend{ m_window };
+	// Overlay drawn again every update step, empty in release builds.
+	DebugDraw m_debugDraw;
+	// Number of draw calls issued by the last render().
+	unsigned m_drawCallCount{ 0 };
 	sf::Sprite m_tankBaseSprite;
 	sf::Sprite m_turretSprite;
 
@@ -105,7 +203,12 @@ protected:
 
 	bool m_fireRequest{ false };
 
-	thor::Timer m_timer;
+	// Drives all gameplay timers from the simulation clock.
+	TimerWheel m_timerWheel;
+
+	// The fire charge timer...the projectile is released when it fires.
+	TimerWheel::Handle m_chargeTimer;
+	bool m_projectileReleased{ false };
 	static constexpr float TIMER_DURATION = 500.0f;
 
 	// Approx. length of turret
@@ -0,0 +1,126 @@
+#include "InputAction.h"
+
+#include <cassert>
+
+namespace
+{
+	// Returns the bit of a key or button action of the given type.
+	std::uint16_t typedBit(std::uint16_t t_held, std::uint16_t t_pressed, std::uint16_t t_released,
+		int t_code, InputAction::Type t_type)
+	{
+		switch (t_type)
+		{
+		case InputAction::PressOnce:
+			return static_cast<std::uint16_t>(t_pressed + t_code);
+		case InputAction::ReleaseOnce:
+			return static_cast<std::uint16_t>(t_released + t_code);
+		case InputAction::Hold:
+		default:
+			return static_cast<std::uint16_t>(t_held + t_code);
+		}
+	}
+
+	// Concatenates the programs of both operands and appends the operator.
+	std::vector<InputAction::Instruction> combine(const InputAction& t_lhs, const InputAction& t_rhs,
+		InputAction::Instruction::Op t_op)
+	{
+		std::vector<InputAction::Instruction> program;
+		program.reserve(t_lhs.getProgram().size() + t_rhs.getProgram().size() + 1);
+		program.insert(program.end(), t_lhs.getProgram().begin(), t_lhs.getProgram().end());
+		program.insert(program.end(), t_rhs.getProgram().begin(), t_rhs.getProgram().end());
+		program.push_back(InputAction::Instruction{ t_op, 0 });
+		return program;
+	}
+}
+
+////////////////////////////////////////////////////////////
+InputAction::InputAction(sf::Keyboard::Key t_key, Type t_type)
+	: InputAction(typedBit(KEY_HELD, KEY_PRESSED, KEY_RELEASED, t_key, t_type))
+{
+	assert(t_key >= 0 && t_key < sf::Keyboard::KeyCount);
+}
+
+////////////////////////////////////////////////////////////
+InputAction::InputAction(sf::Mouse::Button t_button, Type t_type)
+	: InputAction(typedBit(BUTTON_HELD, BUTTON_PRESSED, BUTTON_RELEASED, t_button, t_type))
+{
+	assert(t_button >= 0 && t_button < sf::Mouse::ButtonCount);
+}
+
+////////////////////////////////////////////////////////////
+InputAction::InputAction(sf::Event::EventType t_eventType)
+	: InputAction(static_cast<std::uint16_t>(EVENT_OCCURRED + t_eventType))
+{
+	assert(t_eventType >= 0 && t_eventType < sf::Event::Count);
+}
+
+////////////////////////////////////////////////////////////
+InputAction::InputAction(std::uint16_t t_bit)
+	: m_program(1, Instruction{ Instruction::TEST, t_bit })
+{
+}
+
+////////////////////////////////////////////////////////////
+bool InputAction::isEmpty() const
+{
+	return m_program.empty();
+}
+
+////////////////////////////////////////////////////////////
+const std::vector<InputAction::Instruction>& InputAction::getProgram() const
+{
+	return m_program;
+}
+
+////////////////////////////////////////////////////////////
+InputAction operator||(const InputAction& t_lhs, const InputAction& t_rhs)
+{
+	// An empty action is never active, so it does not change a disjunction.
+	if (t_lhs.isEmpty())
+	{
+		return t_rhs;
+	}
+	if (t_rhs.isEmpty())
+	{
+		return t_lhs;
+	}
+
+	InputAction result;
+	result.m_program = combine(t_lhs, t_rhs, InputAction::Instruction::OR);
+	return result;
+}
+
+////////////////////////////////////////////////////////////
+InputAction operator&&(const InputAction& t_lhs, const InputAction& t_rhs)
+{
+	// An empty action is never active, so neither is a conjunction with it.
+	if (t_lhs.isEmpty() || t_rhs.isEmpty())
+	{
+		return InputAction();
+	}
+
+	InputAction result;
+	result.m_program = combine(t_lhs, t_rhs, InputAction::Instruction::AND);
+	return result;
+}
+
+////////////////////////////////////////////////////////////
+InputAction operator!(const InputAction& t_action)
+{
+	// The program of an empty action pushes nothing, so NOT would have no value to negate.
+	InputAction result;
+	if (t_action.isEmpty())
+	{
+		result.m_program.push_back(InputAction::Instruction{ InputAction::Instruction::ALWAYS, 0 });
+		return result;
+	}
+	// Negating an always active action gives an empty one again.
+	if (t_action.m_program.size() == 1 && t_action.m_program[0].op == InputAction::Instruction::ALWAYS)
+	{
+		return result;
+	}
+
+	result.m_program = t_action.m_program;
+	result.m_program.push_back(InputAction::Instruction{ InputAction::Instruction::NOT, 0 });
+	return result;
+}
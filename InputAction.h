@@ -0,0 +1,114 @@
+#pragma once
+
+#include <SFML/Window/Event.hpp>
+#include <SFML/Window/Keyboard.hpp>
+#include <SFML/Window/Mouse.hpp>
+
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// @brief Description of an input constellation, e.g. "Shift held and X pressed".
+///
+/// Works like thor::Action, but instead of a tree of virtual nodes the action is
+///  stored as a short postfix program over input bits. InputActionMap::compile()
+///  concatenates the programs of all actions, so that every action is evaluated
+///  once per frame in a single linear pass.
+/// Example usage:
+///		InputAction shift = InputAction(sf::Keyboard::LShift) || InputAction(sf::Keyboard::RShift);
+///		InputAction shiftX = shift && InputAction(sf::Keyboard::X, InputAction::PressOnce);
+/// </summary>
+class InputAction
+{
+public:
+	/// <summary>
+	/// @brief Which input makes a key or mouse button action active.
+	/// </summary>
+	enum Type
+	{
+		Hold,			// The key or button is currently held down (realtime state).
+		PressOnce,		// A pressed event occurred this frame.
+		ReleaseOnce		// A released event occurred this frame.
+	};
+
+	/// <summary>
+	/// @brief Bit layout of the per-frame input state that actions are evaluated against.
+	/// </summary>
+	enum Bits : std::uint16_t
+	{
+		KEY_HELD = 0,
+		KEY_PRESSED = KEY_HELD + sf::Keyboard::KeyCount,
+		KEY_RELEASED = KEY_PRESSED + sf::Keyboard::KeyCount,
+		BUTTON_HELD = KEY_RELEASED + sf::Keyboard::KeyCount,
+		BUTTON_PRESSED = BUTTON_HELD + sf::Mouse::ButtonCount,
+		BUTTON_RELEASED = BUTTON_PRESSED + sf::Mouse::ButtonCount,
+		EVENT_OCCURRED = BUTTON_RELEASED + sf::Mouse::ButtonCount,
+		BIT_COUNT = EVENT_OCCURRED + sf::Event::Count
+	};
+
+	/// <summary>
+	/// @brief One step of an action program.
+	/// </summary>
+	struct Instruction
+	{
+		enum Op : std::uint16_t
+		{
+			TEST,	// Push the input bit given by operand.
+			AND,	// Pop two values, push their conjunction.
+			OR,		// Pop two values, push their disjunction.
+			NOT,	// Negate the top value.
+			ALWAYS,	// Push true; the program of the negation of an empty action.
+			STORE	// Pop the result of the action given by operand (only in compiled programs).
+		};
+
+		Op op;
+		std::uint16_t operand;
+	};
+
+	/// <summary>
+	/// @brief Creates an action that is never active.
+	/// </summary>
+	InputAction() = default;
+
+	explicit InputAction(sf::Keyboard::Key t_key, Type t_type = Hold);
+
+	explicit InputAction(sf::Mouse::Button t_button, Type t_type = Hold);
+
+	/// <summary>
+	/// @brief Creates an action that is active if an event of the given type occurred this frame.
+	/// </summary>
+	explicit InputAction(sf::Event::EventType t_eventType);
+
+	/// <summary>
+	/// @brief Returns true if the action never becomes active.
+	/// </summary>
+	bool isEmpty() const;
+
+	const std::vector<Instruction>& getProgram() const;
+
+	friend InputAction operator||(const InputAction& t_lhs, const InputAction& t_rhs);
+	friend InputAction operator&&(const InputAction& t_lhs, const InputAction& t_rhs);
+	friend InputAction operator!(const InputAction& t_action);
+
+private:
+	explicit InputAction(std::uint16_t t_bit);
+
+	// Postfix program that leaves exactly one value on the stack.
+	std::vector<Instruction> m_program;
+};
+
+/// <summary>
+/// @brief The resulting action is active if at least one of the operands is active.
+/// </summary>
+InputAction operator||(const InputAction& t_lhs, const InputAction& t_rhs);
+
+/// <summary>
+/// @brief The resulting action is active if both operands are active.
+/// </summary>
+InputAction operator&&(const InputAction& t_lhs, const InputAction& t_rhs);
+
+/// <summary>
+/// @brief The resulting action is active if the operand is not active.
+/// An empty action is never active, so its negation is always active.
+/// </summary>
+InputAction operator!(const InputAction& t_action);
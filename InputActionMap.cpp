@@ -0,0 +1,175 @@
+#include "InputActionMap.h"
+
+#include <algorithm>
+#include <cassert>
+
+////////////////////////////////////////////////////////////
+void InputActionMap::setAction(std::size_t t_id, const InputAction& t_action)
+{
+	if (t_id >= m_actions.size())
+	{
+		m_actions.resize(t_id + 1);
+	}
+	m_actions[t_id] = t_action;
+	m_needsCompile = true;
+}
+
+////////////////////////////////////////////////////////////
+void InputActionMap::removeAction(std::size_t t_id)
+{
+	if (t_id < m_actions.size())
+	{
+		m_actions[t_id] = InputAction();
+		m_needsCompile = true;
+	}
+}
+
+////////////////////////////////////////////////////////////
+void InputActionMap::clearActions()
+{
+	m_actions.clear();
+	m_needsCompile = true;
+}
+
+////////////////////////////////////////////////////////////
+void InputActionMap::compile()
+{
+	m_program.clear();
+	m_sampledKeys.clear();
+	m_sampledButtons.clear();
+
+	InputBits sampled;
+	for (std::size_t id = 0; id < m_actions.size(); ++id)
+	{
+		const std::vector<InputAction::Instruction>& program = m_actions[id].getProgram();
+		if (program.empty())
+		{
+			continue;
+		}
+
+		for (const InputAction::Instruction& instruction : program)
+		{
+			if (instruction.op == InputAction::Instruction::TEST)
+			{
+				sampled.set(instruction.operand);
+			}
+		}
+		m_program.insert(m_program.end(), program.begin(), program.end());
+		m_program.push_back(InputAction::Instruction{ InputAction::Instruction::STORE, static_cast<std::uint16_t>(id) });
+	}
+
+	for (int key = 0; key < sf::Keyboard::KeyCount; ++key)
+	{
+		if (sampled.test(InputAction::KEY_HELD + key))
+		{
+			m_sampledKeys.push_back(static_cast<sf::Keyboard::Key>(key));
+		}
+	}
+	for (int button = 0; button < sf::Mouse::ButtonCount; ++button)
+	{
+		if (sampled.test(InputAction::BUTTON_HELD + button))
+		{
+			m_sampledButtons.push_back(static_cast<sf::Mouse::Button>(button));
+		}
+	}
+
+	m_results.assign(m_actions.size(), false);
+	m_needsCompile = false;
+}
+
+////////////////////////////////////////////////////////////
+void InputActionMap::clearEvents()
+{
+	m_events.clear();
+}
+
+////////////////////////////////////////////////////////////
+void InputActionMap::pushEvent(const sf::Event& t_event)
+{
+	m_events.push(t_event);
+
+	if (t_event.type == sf::Event::LostFocus)
+	{
+		m_realtimeEnabled = false;
+	}
+	else if (t_event.type == sf::Event::GainedFocus)
+	{
+		m_realtimeEnabled = true;
+	}
+}
+
+////////////////////////////////////////////////////////////
+void InputActionMap::update()
+{
+	if (m_needsCompile)
+	{
+		compile();
+	}
+
+	// Build this frame's input bits: events plus the realtime state of referenced keys and buttons.
+	m_inputBits.reset();
+	for (std::uint16_t bit : m_events.getUsedBuckets())
+	{
+		m_inputBits.set(bit);
+	}
+	if (m_realtimeEnabled)
+	{
+		for (sf::Keyboard::Key key : m_sampledKeys)
+		{
+			m_inputBits[InputAction::KEY_HELD + key] = sf::Keyboard::isKeyPressed(key);
+		}
+		for (sf::Mouse::Button button : m_sampledButtons)
+		{
+			m_inputBits[InputAction::BUTTON_HELD + button] = sf::Mouse::isButtonPressed(button);
+		}
+	}
+
+	// Run all action programs in one pass.
+	m_stack.clear();
+	for (const InputAction::Instruction& instruction : m_program)
+	{
+		switch (instruction.op)
+		{
+		case InputAction::Instruction::TEST:
+			m_stack.push_back(m_inputBits.test(instruction.operand));
+			break;
+		case InputAction::Instruction::AND:
+		{
+			bool rhs = m_stack.back();
+			m_stack.pop_back();
+			m_stack.back() = m_stack.back() && rhs;
+			break;
+		}
+		case InputAction::Instruction::OR:
+		{
+			bool rhs = m_stack.back();
+			m_stack.pop_back();
+			m_stack.back() = m_stack.back() || rhs;
+			break;
+		}
+		case InputAction::Instruction::NOT:
+			m_stack.back() = !m_stack.back();
+			break;
+		case InputAction::Instruction::ALWAYS:
+			m_stack.push_back(true);
+			break;
+		case InputAction::Instruction::STORE:
+			m_results[instruction.operand] = m_stack.back();
+			m_stack.pop_back();
+			break;
+		}
+	}
+	assert(m_stack.empty());
+}
+
+////////////////////////////////////////////////////////////
+bool InputActionMap::isActive(std::size_t t_id) const
+{
+	return t_id < m_results.size() && m_results[t_id];
+}
+
+////////////////////////////////////////////////////////////
+const InputEventBuffer& InputActionMap::getEvents() const
+{
+	return m_events;
+}
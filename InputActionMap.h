@@ -0,0 +1,94 @@
+#pragma once
+
+#include <SFML/Window/Event.hpp>
+
+#include <bitset>
+#include <cstdint>
+#include <vector>
+
+#include "InputAction.h"
+#include "InputEventBuffer.h"
+
+/// <summary>
+/// @brief Maps dense action ids to InputActions and evaluates all of them once per frame.
+///
+/// thor::ActionMap walks a tree of virtual nodes per action and rescans the frame's
+///  events for every leaf, each time isActive() is called. Here, compile() flattens
+///  all actions into one postfix program. update() folds the frame's events and the
+///  realtime state of the keys and buttons actually used into a bitmask, and runs
+///  the program once. isActive() is then a single bit test.
+/// Action ids are small integers, typically the values of an enum.
+/// Example usage:
+///		map.setAction(FIRE, InputAction(sf::Keyboard::Space, InputAction::PressOnce));
+///		map.clearEvents();
+///		while (window.pollEvent(event)) map.pushEvent(event);
+///		map.update();
+///		if (map.isActive(FIRE)) ...
+/// </summary>
+class InputActionMap
+{
+public:
+	/// <summary>
+	/// @brief Associates an action with an id, replacing any previous one.
+	/// The program is recompiled by the next update().
+	/// </summary>
+	void setAction(std::size_t t_id, const InputAction& t_action);
+
+	void removeAction(std::size_t t_id);
+
+	void clearActions();
+
+	/// <summary>
+	/// @brief Flattens all actions into one program.
+	/// Called automatically by update() when actions have changed.
+	/// </summary>
+	void compile();
+
+	/// <summary>
+	/// @brief Removes the events stored for the current frame.
+	/// </summary>
+	void clearEvents();
+
+	/// <summary>
+	/// @brief Records an event for the current frame.
+	/// </summary>
+	void pushEvent(const sf::Event& t_event);
+
+	/// <summary>
+	/// @brief Samples the realtime input state and evaluates all actions.
+	/// Call once per frame, after the frame's events have been pushed.
+	/// </summary>
+	void update();
+
+	/// <summary>
+	/// @brief Returns whether the action was active at the last update().
+	/// </summary>
+	bool isActive(std::size_t t_id) const;
+
+	/// <summary>
+	/// @brief Returns the events of the current frame, e.g. to read the position of a click.
+	/// </summary>
+	const InputEventBuffer& getEvents() const;
+
+private:
+	typedef std::bitset<InputAction::BIT_COUNT> InputBits;
+
+	std::vector<InputAction> m_actions;
+	bool m_needsCompile{ false };
+
+	// All actions in one postfix program, each terminated by a STORE.
+	std::vector<InputAction::Instruction> m_program;
+	// Realtime keys and buttons referenced by the program; only these are sampled.
+	std::vector<sf::Keyboard::Key> m_sampledKeys;
+	std::vector<sf::Mouse::Button> m_sampledButtons;
+
+	// Events and input state of the current frame.
+	InputEventBuffer m_events;
+	InputBits m_inputBits;
+	// Realtime input is ignored while the window does not have focus.
+	bool m_realtimeEnabled{ true };
+
+	// Evaluation stack and results, reused across frames.
+	std::vector<bool> m_stack;
+	std::vector<bool> m_results;
+};
@@ -0,0 +1,86 @@
+#include "InputEventBuffer.h"
+
+////////////////////////////////////////////////////////////
+InputEventBuffer::InputEventBuffer()
+	: m_buckets(InputAction::BIT_COUNT)
+{
+}
+
+////////////////////////////////////////////////////////////
+void InputEventBuffer::clear()
+{
+	for (std::uint16_t bit : m_usedBuckets)
+	{
+		m_buckets[bit].clear();
+	}
+	m_usedBuckets.clear();
+}
+
+////////////////////////////////////////////////////////////
+void InputEventBuffer::push(const sf::Event& t_event)
+{
+	add(static_cast<std::uint16_t>(InputAction::EVENT_OCCURRED + t_event.type), t_event);
+
+	switch (t_event.type)
+	{
+	case sf::Event::KeyPressed:
+	case sf::Event::KeyReleased:
+		// Keys unknown to SFML only go into the type bucket.
+		if (t_event.key.code >= 0 && t_event.key.code < sf::Keyboard::KeyCount)
+		{
+			std::uint16_t base = t_event.type == sf::Event::KeyPressed ? InputAction::KEY_PRESSED : InputAction::KEY_RELEASED;
+			add(static_cast<std::uint16_t>(base + t_event.key.code), t_event);
+		}
+		break;
+	case sf::Event::MouseButtonPressed:
+	case sf::Event::MouseButtonReleased:
+	{
+		std::uint16_t base = t_event.type == sf::Event::MouseButtonPressed ? InputAction::BUTTON_PRESSED : InputAction::BUTTON_RELEASED;
+		add(static_cast<std::uint16_t>(base + t_event.mouseButton.button), t_event);
+		break;
+	}
+	default:
+		break;
+	}
+}
+
+////////////////////////////////////////////////////////////
+const std::vector<sf::Event>& InputEventBuffer::getEvents(sf::Event::EventType t_type) const
+{
+	return m_buckets[InputAction::EVENT_OCCURRED + t_type];
+}
+
+////////////////////////////////////////////////////////////
+const std::vector<sf::Event>& InputEventBuffer::getKeyEvents(sf::Keyboard::Key t_key, bool t_pressed) const
+{
+	return m_buckets[(t_pressed ? InputAction::KEY_PRESSED : InputAction::KEY_RELEASED) + t_key];
+}
+
+////////////////////////////////////////////////////////////
+const std::vector<sf::Event>& InputEventBuffer::getButtonEvents(sf::Mouse::Button t_button, bool t_pressed) const
+{
+	return m_buckets[(t_pressed ? InputAction::BUTTON_PRESSED : InputAction::BUTTON_RELEASED) + t_button];
+}
+
+////////////////////////////////////////////////////////////
+const std::vector<sf::Event>& InputEventBuffer::getBucket(std::uint16_t t_bit) const
+{
+	return m_buckets[t_bit];
+}
+
+////////////////////////////////////////////////////////////
+const std::vector<std::uint16_t>& InputEventBuffer::getUsedBuckets() const
+{
+	return m_usedBuckets;
+}
+
+////////////////////////////////////////////////////////////
+void InputEventBuffer::add(std::uint16_t t_bit, const sf::Event& t_event)
+{
+	std::vector<sf::Event>& bucket = m_buckets[t_bit];
+	if (bucket.empty())
+	{
+		m_usedBuckets.push_back(t_bit);
+	}
+	bucket.push_back(t_event);
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <SFML/Window/Event.hpp>
+#include <SFML/Window/Keyboard.hpp>
+#include <SFML/Window/Mouse.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include "InputAction.h"
+
+/// <summary>
+/// @brief Stores the events of one frame, bucketed by what they are about.
+///
+/// Every event goes into the bucket of its event type; key and mouse button
+///  events additionally go into the bucket of their code. Looking up e.g. all
+///  presses of the space key is then a direct bucket read instead of a scan over
+///  all events of the frame, which matters during bursts like mouse-move floods.
+/// Buckets are numbered like the event bits of InputAction, and clear() only
+///  empties the buckets that were used, keeping their storage for the next frame.
+/// </summary>
+class InputEventBuffer
+{
+public:
+	InputEventBuffer();
+
+	/// <summary>
+	/// @brief Removes all events without releasing storage.
+	/// </summary>
+	void clear();
+
+	void push(const sf::Event& t_event);
+
+	/// <summary>
+	/// @brief Returns all events of the given type, in the order they were pushed.
+	/// </summary>
+	const std::vector<sf::Event>& getEvents(sf::Event::EventType t_type) const;
+
+	/// <summary>
+	/// @brief Returns the KeyPressed or KeyReleased events of one key.
+	/// </summary>
+	const std::vector<sf::Event>& getKeyEvents(sf::Keyboard::Key t_key, bool t_pressed) const;
+
+	/// <summary>
+	/// @brief Returns the MouseButtonPressed or MouseButtonReleased events of one button.
+	/// </summary>
+	const std::vector<sf::Event>& getButtonEvents(sf::Mouse::Button t_button, bool t_pressed) const;
+
+	/// <summary>
+	/// @brief Returns the bucket with the given InputAction bit index.
+	/// Held bits never have events.
+	/// </summary>
+	const std::vector<sf::Event>& getBucket(std::uint16_t t_bit) const;
+
+	/// <summary>
+	/// @brief Returns the InputAction bit indices of all non-empty buckets.
+	/// </summary>
+	const std::vector<std::uint16_t>& getUsedBuckets() const;
+
+private:
+	void add(std::uint16_t t_bit, const sf::Event& t_event);
+
+	std::vector<std::vector<sf::Event>> m_buckets;
+	std::vector<std::uint16_t> m_usedBuckets;
+};
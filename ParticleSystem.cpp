@@ -2,17 +2,32 @@
 
 ParticleSystem::ParticleSystem()
 {
-	// Load the texture needed for the particle system
-	if (!m_particleTexture.loadFromFile("./resources/assets/graphics/SmokeTexture.png"))
+	// Register a single emitter and affector with Thor, which forward to ours.
+	m_particleSystem.addEmitter([this](thor::EmissionInterface& t_system, sf::Time t_dt)
 	{
-		std::string s("Error loading texture");
-		throw std::exception(s.c_str());
-	}
+		for (Timed<EmitterFunction>& emitter : m_activeEmitters)
+		{
+			emitter.function(t_system, t_dt);
+		}
+	});
+	// Thor only calls affectors for living particles, so after ours ran, the particle is in the state it is drawn in.
+	m_particleSystem.addAffector([this](thor::Particle& t_particle, sf::Time t_dt)
+	{
+		for (Timed<AffectorFunction>& affector : m_activeAffectors)
+		{
+			affector.function(t_particle, t_dt);
+		}
+		m_drawnParticles.push_back(DrawnParticle{ t_particle.position, t_particle.rotation, t_particle.scale, t_particle.color });
+	});
 }
 
-void ParticleSystem::initParticleSystem()
+void ParticleSystem::initParticleSystem(const sf::Texture& t_texture, const sf::IntRect& t_textureRect)
 {
-	m_particleSystem.setTexture(m_particleTexture);
+	m_particleSystem.setTexture(t_texture);
+	m_texture = &t_texture;
+	m_textureRect = t_textureRect;
+	// Particles use texture index 0, which is this rect.
+	m_particleSystem.addTextureRect(t_textureRect);
 	// Create 3 particle emitters.
 	for (int i = 0; i < 3; i++)
 	{
@@ -31,17 +46,121 @@ void ParticleSystem::generateParticles(int t_x, int t_y)
 	// Emit particles in given circle at x,y position with radius of 10.
 	m_emitters.at(m_emitterIndex).setParticlePosition(thor::Distributions::circle(sf::Vector2f(t_x, t_y), 10));
 	// Add an emitter...this emitter will be removed after 400 milliseconds.
-	m_particleSystem.addEmitter(thor::refEmitter(m_emitters.at(m_emitterIndex)), sf::milliseconds(400));
+	addEmitter(thor::refEmitter(m_emitters.at(m_emitterIndex)), sf::milliseconds(400));
 	m_emitterIndex = (m_emitterIndex + 1) % 3;
 }
 
 void ParticleSystem::update(double dt)
 {
-	// Update particle system (needs delta time between frames)
-	m_particleSystem.update(sf::Time(sf::milliseconds(dt)));
+	sf::Time frameTime = sf::Time(sf::milliseconds(dt));
+	// Update particle system (needs delta time between frames), capturing the particles anew.
+	m_drawnParticles.clear();
+	m_particleSystem.update(frameTime);
+
+	// Remove the emitters and affectors whose time is up.
+	m_removalTimers.advance(frameTime);
 }
 
-void ParticleSystem::render(sf::RenderWindow& t_window)
+////////////////////////////////////////////////////////////
+void ParticleSystem::record(RenderCommandBuffer& t_commands, RenderLayer t_layer) const
+{
+	if (m_drawnParticles.empty())
+	{
+		return;
+	}
+
+	// Same quads as thor::ParticleSystem: the texture rect centred on the particle, then scaled, rotated and moved.
+	sf::FloatRect rect(m_textureRect);
+	const sf::Vector2f corners[4] =
+	{
+		sf::Vector2f(-rect.width, -rect.height) / 2.f,
+		sf::Vector2f(rect.width, -rect.height) / 2.f,
+		sf::Vector2f(rect.width, rect.height) / 2.f,
+		sf::Vector2f(-rect.width, rect.height) / 2.f
+	};
+	const sf::Vector2f texCoords[4] =
+	{
+		sf::Vector2f(rect.left, rect.top),
+		sf::Vector2f(rect.left + rect.width, rect.top),
+		sf::Vector2f(rect.left + rect.width, rect.top + rect.height),
+		sf::Vector2f(rect.left, rect.top + rect.height)
+	};
+
+	sf::Vertex* vertices = t_commands.allocateVertices(4 * m_drawnParticles.size());
+	sf::Vertex* vertex = vertices;
+	for (const DrawnParticle& particle : m_drawnParticles)
+	{
+		sf::Transform transform;
+		transform.translate(particle.position);
+		transform.rotate(particle.rotation);
+		transform.scale(particle.scale);
+
+		for (int i = 0; i < 4; ++i)
+		{
+			*vertex++ = sf::Vertex(transform.transformPoint(corners[i]), particle.color, texCoords[i]);
+		}
+	}
+	t_commands.draw(t_layer, vertices, 4 * m_drawnParticles.size(), sf::Quads, m_texture);
+}
+
+////////////////////////////////////////////////////////////
+ParticleSystem::EmitterHandle ParticleSystem::addEmitter(EmitterFunction t_emitter)
+{
+	return add(m_activeEmitters, std::move(t_emitter), false, sf::Time::Zero);
+}
+
+////////////////////////////////////////////////////////////
+ParticleSystem::EmitterHandle ParticleSystem::addEmitter(EmitterFunction t_emitter, sf::Time t_timeUntilRemoval)
+{
+	return add(m_activeEmitters, std::move(t_emitter), true, t_timeUntilRemoval);
+}
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::removeEmitter(EmitterHandle t_handle)
 {
-	t_window.draw(m_particleSystem);
+	remove(m_activeEmitters, t_handle);
+}
+
+////////////////////////////////////////////////////////////
+ParticleSystem::AffectorHandle ParticleSystem::addAffector(AffectorFunction t_affector)
+{
+	return add(m_activeAffectors, std::move(t_affector), false, sf::Time::Zero);
+}
+
+////////////////////////////////////////////////////////////
+ParticleSystem::AffectorHandle ParticleSystem::addAffector(AffectorFunction t_affector, sf::Time t_timeUntilRemoval)
+{
+	return add(m_activeAffectors, std::move(t_affector), true, t_timeUntilRemoval);
+}
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::removeAffector(AffectorHandle t_handle)
+{
+	remove(m_activeAffectors, t_handle);
+}
+
+////////////////////////////////////////////////////////////
+template <typename Function>
+typename SlotMap<ParticleSystem::Timed<Function>>::Handle ParticleSystem::add(SlotMap<Timed<Function>>& t_entries,
+	Function t_function, bool t_expires, sf::Time t_timeUntilRemoval)
+{
+	typename SlotMap<Timed<Function>>::Handle handle = t_entries.insert(Timed<Function>{ std::move(t_function), TimerWheel::Handle() });
+	if (t_expires)
+	{
+		// Manual removal cancels this timer, so the entry still exists when it fires.
+		t_entries.get(handle)->removalTimer = m_removalTimers.schedule(t_timeUntilRemoval,
+			[&t_entries, handle] { t_entries.erase(handle); });
+	}
+	return handle;
+}
+
+////////////////////////////////////////////////////////////
+template <typename Function>
+void ParticleSystem::remove(SlotMap<Timed<Function>>& t_entries, typename SlotMap<Timed<Function>>::Handle t_handle)
+{
+	if (Timed<Function>* entry = t_entries.get(t_handle))
+	{
+		m_removalTimers.cancel(entry->removalTimer);
+		t_entries.erase(t_handle);
+	}
 }
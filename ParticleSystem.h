@@ -3,28 +3,129 @@
 #include <Thor/Particles.hpp>
 #include <Thor/Math/Distributions.hpp>
 #include <SFML/Graphics.hpp>
+#include <functional>
 #include <vector>
 
+#include "SlotMap.h"
+#include "TimerWheel.h"
+#include "RenderCommandBuffer.h"
+
+/// <summary>
+/// @brief Wraps Thor's particle system and manages its emitters and affectors.
+///
+/// thor::ParticleSystem removes an emitter or affector with a linear search by id.
+///  With one short-lived emitter per shot this becomes quadratic, so the emitters and
+///  affectors are kept here in slot maps instead. Thor only sees one emitter and one
+///  affector that forward to them; adding and removing is O(1) through handles.
+/// Timed entries are scheduled on a timer wheel, so each update only touches the
+///  entries that actually expire instead of counting down every entry.
+/// The forwarding affector also captures the state of every living particle, from
+///  which record() builds the same quads that thor::ParticleSystem draws.
+/// </summary>
 class ParticleSystem
 {
 public:
+	typedef std::function<void(thor::EmissionInterface&, sf::Time)> EmitterFunction;
+	typedef std::function<void(thor::Particle&, sf::Time)> AffectorFunction;
+
+private:
+	// An emitter or affector with an optional removal timer.
+	template <typename Function>
+	struct Timed
+	{
+		Function function;
+		TimerWheel::Handle removalTimer;
+	};
+
+public:
+	typedef SlotMap<Timed<EmitterFunction>>::Handle EmitterHandle;
+	typedef SlotMap<Timed<AffectorFunction>>::Handle AffectorHandle;
+
 	ParticleSystem();
 
-	void initParticleSystem();
+	/// <summary>
+	/// @brief Sets up the emitters and affectors.
+	/// </summary>
+	/// <param name="t_texture">The texture particles are drawn from, must outlive the particle system</param>
+	/// <param name="t_textureRect">The area of the particle image within the texture</param>
+	void initParticleSystem(const sf::Texture& t_texture, const sf::IntRect& t_textureRect);
 
 	void generateParticles(int t_x, int t_y);
 
 	void update(double dt);
 
-	void render(sf::RenderWindow& t_window);
+	/// <summary>
+	/// @brief Records the particles of the last update as a single draw command of textured quads.
+	/// </summary>
+	void record(RenderCommandBuffer& t_commands, RenderLayer t_layer) const;
+
+	/// <summary>
+	/// @brief Adds an emitter that stays until it is removed.
+	/// </summary>
+	/// <returns>A handle that can be used to remove the emitter.</returns>
+	EmitterHandle addEmitter(EmitterFunction t_emitter);
+
+	/// <summary>
+	/// @brief Adds an emitter that is removed automatically after the given time.
+	/// </summary>
+	EmitterHandle addEmitter(EmitterFunction t_emitter, sf::Time t_timeUntilRemoval);
+
+	/// <summary>
+	/// @brief Removes an emitter in O(1). Stale handles are ignored.
+	/// </summary>
+	void removeEmitter(EmitterHandle t_handle);
+
+	/// <summary>
+	/// @brief Adds an affector that stays until it is removed.
+	/// </summary>
+	AffectorHandle addAffector(AffectorFunction t_affector);
+
+	/// <summary>
+	/// @brief Adds an affector that is removed automatically after the given time.
+	/// </summary>
+	AffectorHandle addAffector(AffectorFunction t_affector, sf::Time t_timeUntilRemoval);
+
+	/// <summary>
+	/// @brief Removes an affector in O(1). Stale handles are ignored.
+	/// </summary>
+	void removeAffector(AffectorHandle t_handle);
+
+private:
+	// What record() needs to know about a particle.
+	struct DrawnParticle
+	{
+		sf::Vector2f position;
+		float rotation;
+		sf::Vector2f scale;
+		sf::Color color;
+	};
+
+	// Stores an entry and, if requested, schedules its removal.
+	template <typename Function>
+	typename SlotMap<Timed<Function>>::Handle add(SlotMap<Timed<Function>>& t_entries, Function t_function,
+		bool t_expires, sf::Time t_timeUntilRemoval);
+
+	// Removes an entry and cancels its removal timer.
+	template <typename Function>
+	void remove(SlotMap<Timed<Function>>& t_entries, typename SlotMap<Timed<Function>>::Handle t_handle);
 
-private:	
 	// Thor's particle system instance.
 	thor::ParticleSystem m_particleSystem;
-	// The texture for this particle system.
-	sf::Texture m_particleTexture;
+	// The texture the particles are drawn from.
+	const sf::Texture* m_texture{ nullptr };
+	// The area of the particle image, texture rect 0 of Thor's particle system.
+	sf::IntRect m_textureRect;
+	// Living particles after the last update, in Thor's order.
+	std::vector<DrawnParticle> m_drawnParticles;
 	// A collection of particle emitters.
 	std::vector<thor::UniversalEmitter> m_emitters;
 	// The index of the next available emitter.
 	int m_emitterIndex{ 0 };
-};
\ No newline at end of file
+
+	// Emitters and affectors invoked by the forwarding functions registered with Thor.
+	SlotMap<Timed<EmitterFunction>> m_activeEmitters;
+	SlotMap<Timed<AffectorFunction>> m_activeAffectors;
+
+	// Deadlines of timed emitters and affectors, advanced with the particle system.
+	TimerWheel m_removalTimers{ sf::milliseconds(1) };
+};
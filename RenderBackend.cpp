@@ -0,0 +1,76 @@
+#include "RenderBackend.h"
+
+////////////////////////////////////////////////////////////
+SfmlRenderBackend::SfmlRenderBackend(sf::RenderTarget& t_target)
+	: m_target(t_target)
+{
+}
+
+////////////////////////////////////////////////////////////
+void SfmlRenderBackend::submit(const RenderCommandBuffer& t_commands)
+{
+	m_drawCallCount = 0;
+	for (const RenderCommandBuffer::Command& command : t_commands.getCommands())
+	{
+		const DrawPacket& packet = *command.packet;
+		sf::RenderStates states(t_commands.getBlendModes()[packet.blendMode]);
+		states.texture = packet.texture;
+
+		if (packet.drawable)
+		{
+			m_target.draw(*packet.drawable, states);
+		}
+		else
+		{
+			m_target.draw(packet.vertices, packet.vertexCount, packet.primitiveType, states);
+		}
+		++m_drawCallCount;
+	}
+}
+
+////////////////////////////////////////////////////////////
+void NullRenderBackend::submit(const RenderCommandBuffer& t_commands)
+{
+	m_drawCallCount = 0;
+	m_vertexCount = 0;
+	m_stateChangeCount = 0;
+	m_checksum = 0;
+
+	const sf::Texture* texture = nullptr;
+	std::uint8_t blendMode = 0xFF;
+	for (const RenderCommandBuffer::Command& command : t_commands.getCommands())
+	{
+		const DrawPacket& packet = *command.packet;
+		if (packet.texture != texture || packet.blendMode != blendMode)
+		{
+			texture = packet.texture;
+			blendMode = packet.blendMode;
+			++m_stateChangeCount;
+		}
+
+		for (std::uint32_t i = 0; i < packet.vertexCount; ++i)
+		{
+			m_checksum += packet.vertices[i].position.x + packet.vertices[i].position.y;
+		}
+		m_vertexCount += packet.vertexCount;
+		++m_drawCallCount;
+	}
+}
+
+////////////////////////////////////////////////////////////
+std::size_t NullRenderBackend::getVertexCount() const
+{
+	return m_vertexCount;
+}
+
+////////////////////////////////////////////////////////////
+std::size_t NullRenderBackend::getStateChangeCount() const
+{
+	return m_stateChangeCount;
+}
+
+////////////////////////////////////////////////////////////
+float NullRenderBackend::getChecksum() const
+{
+	return m_checksum;
+}
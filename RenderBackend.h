@@ -0,0 +1,76 @@
+#pragma once
+
+#include <SFML/Graphics/RenderTarget.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "RenderCommandBuffer.h"
+
+/// <summary>
+/// @brief Executes a sorted RenderCommandBuffer.
+/// </summary>
+class RenderBackend
+{
+public:
+	virtual ~RenderBackend() = default;
+
+	/// <summary>
+	/// @brief Executes all commands in their current order.
+	/// </summary>
+	virtual void submit(const RenderCommandBuffer& t_commands) = 0;
+
+	/// <summary>
+	/// @brief Returns the number of draw calls issued by the last submit().
+	/// </summary>
+	std::size_t getDrawCallCount() const { return m_drawCallCount; }
+
+protected:
+	std::size_t m_drawCallCount{ 0 };
+};
+
+/// <summary>
+/// @brief Draws the commands to an SFML render target.
+/// </summary>
+class SfmlRenderBackend : public RenderBackend
+{
+public:
+	explicit SfmlRenderBackend(sf::RenderTarget& t_target);
+
+	void submit(const RenderCommandBuffer& t_commands) override;
+
+private:
+	sf::RenderTarget& m_target;
+};
+
+/// <summary>
+/// @brief Walks the commands like a real backend would, without a GPU.
+///
+/// Reads every packet and vertex, so that command generation, sorting and
+///  submission can be benchmarked headless. Drawables are counted but not drawn.
+/// </summary>
+class NullRenderBackend : public RenderBackend
+{
+public:
+	void submit(const RenderCommandBuffer& t_commands) override;
+
+	/// <summary>
+	/// @brief Returns the number of vertices read by the last submit().
+	/// </summary>
+	std::size_t getVertexCount() const;
+
+	/// <summary>
+	/// @brief Returns the number of texture or blend mode changes in the last submit().
+	/// </summary>
+	std::size_t getStateChangeCount() const;
+
+	/// <summary>
+	/// @brief Returns a checksum of the submitted vertex positions, so that reading them cannot be optimised away.
+	/// </summary>
+	float getChecksum() const;
+
+private:
+	std::size_t m_vertexCount{ 0 };
+	std::size_t m_stateChangeCount{ 0 };
+	float m_checksum{ 0 };
+};
@@ -0,0 +1,127 @@
+#include "RenderCommandBuffer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <new>
+#include <type_traits>
+
+////////////////////////////////////////////////////////////
+sf::Vertex* RenderCommandBuffer::allocateVertices(std::size_t t_count)
+{
+	return allocateArray<sf::Vertex>(t_count);
+}
+
+////////////////////////////////////////////////////////////
+void RenderCommandBuffer::draw(RenderLayer t_layer, const sf::Vertex* t_vertices, std::size_t t_count, sf::PrimitiveType t_type,
+	const sf::Texture* t_texture, const sf::BlendMode& t_blendMode)
+{
+	DrawPacket& packet = *allocateArray<DrawPacket>(1);
+	packet.vertices = t_vertices;
+	packet.vertexCount = static_cast<std::uint32_t>(t_count);
+	packet.primitiveType = t_type;
+	packet.drawable = nullptr;
+	packet.texture = t_texture;
+	record(t_layer, packet, t_blendMode);
+}
+
+////////////////////////////////////////////////////////////
+void RenderCommandBuffer::draw(RenderLayer t_layer, const sf::Drawable& t_drawable, const sf::Texture* t_texture,
+	const sf::BlendMode& t_blendMode)
+{
+	DrawPacket& packet = *allocateArray<DrawPacket>(1);
+	packet.vertices = nullptr;
+	packet.vertexCount = 0;
+	packet.primitiveType = sf::Triangles;
+	packet.drawable = &t_drawable;
+	packet.texture = t_texture;
+	record(t_layer, packet, t_blendMode);
+}
+
+////////////////////////////////////////////////////////////
+void RenderCommandBuffer::sort()
+{
+	// Keys are unique thanks to the sequence number, so an unstable sort is enough.
+	std::sort(m_commands.begin(), m_commands.end(), [](const Command& t_lhs, const Command& t_rhs)
+	{
+		return t_lhs.key < t_rhs.key;
+	});
+}
+
+////////////////////////////////////////////////////////////
+void RenderCommandBuffer::clear()
+{
+	m_commands.clear();
+	m_arena.reset();
+}
+
+////////////////////////////////////////////////////////////
+const std::vector<RenderCommandBuffer::Command>& RenderCommandBuffer::getCommands() const
+{
+	return m_commands;
+}
+
+////////////////////////////////////////////////////////////
+const std::vector<sf::BlendMode>& RenderCommandBuffer::getBlendModes() const
+{
+	return m_blendModes;
+}
+
+////////////////////////////////////////////////////////////
+const thor::MemoryArena& RenderCommandBuffer::getArena() const
+{
+	return m_arena;
+}
+
+////////////////////////////////////////////////////////////
+void RenderCommandBuffer::record(RenderLayer t_layer, DrawPacket& t_packet, const sf::BlendMode& t_blendMode)
+{
+	t_packet.blendMode = getBlendModeId(t_blendMode);
+
+	std::uint64_t key = std::uint64_t(static_cast<std::uint8_t>(t_layer)) << 56
+		| std::uint64_t(getTextureId(t_packet.texture)) << 40
+		| std::uint64_t(t_packet.blendMode) << 32
+		| static_cast<std::uint32_t>(m_commands.size());
+
+	m_commands.push_back(Command{ key, &t_packet });
+}
+
+////////////////////////////////////////////////////////////
+std::uint16_t RenderCommandBuffer::getTextureId(const sf::Texture* t_texture)
+{
+	// A frame uses a handful of textures, a linear search is fastest.
+	auto found = std::find(m_textures.begin(), m_textures.end(), t_texture);
+	if (found == m_textures.end())
+	{
+		assert(m_textures.size() < 0xFFFF);
+		m_textures.push_back(t_texture);
+		found = m_textures.end() - 1;
+	}
+	return static_cast<std::uint16_t>(found - m_textures.begin());
+}
+
+////////////////////////////////////////////////////////////
+std::uint8_t RenderCommandBuffer::getBlendModeId(const sf::BlendMode& t_blendMode)
+{
+	auto found = std::find(m_blendModes.begin(), m_blendModes.end(), t_blendMode);
+	if (found == m_blendModes.end())
+	{
+		assert(m_blendModes.size() < 0xFF);
+		m_blendModes.push_back(t_blendMode);
+		found = m_blendModes.end() - 1;
+	}
+	return static_cast<std::uint8_t>(found - m_blendModes.begin());
+}
+
+////////////////////////////////////////////////////////////
+template <typename T>
+T* RenderCommandBuffer::allocateArray(std::size_t t_count)
+{
+	static_assert(std::is_trivially_destructible<T>::value, "thor::MemoryArena never runs destructors");
+
+	T* objects = static_cast<T*>(m_arena.allocate(sizeof(T) * t_count, alignof(T)));
+	for (std::size_t i = 0; i < t_count; ++i)
+	{
+		new (objects + i) T;
+	}
+	return objects;
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <SFML/Graphics/BlendMode.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/PrimitiveType.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <Thor/Math/MemoryArena.hpp>
+
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// @brief Draw layers, drawn in this order. Within a layer, draws are grouped by texture and blend mode.
+/// </summary>
+enum class RenderLayer : std::uint8_t
+{
+	World,
+	Effects,
+	Hud
+};
+
+/// <summary>
+/// @brief One draw, as plain data.
+/// Either a range of vertices, or an sf::Drawable that can only draw itself
+///  (e.g. thor::ParticleSystem); then vertices is nullptr.
+/// </summary>
+struct DrawPacket
+{
+	const sf::Vertex* vertices;
+	std::uint32_t vertexCount;
+	sf::PrimitiveType primitiveType;
+	const sf::Drawable* drawable;
+	const sf::Texture* texture;
+	// Index into RenderCommandBuffer::getBlendModes().
+	std::uint8_t blendMode;
+};
+
+/// <summary>
+/// @brief Retained list of draws for one frame, recorded first and submitted later.
+///
+/// Recording does not call into SFML, so it can happen on the update thread while
+///  a backend (see RenderBackend.h) submits the previous frame's buffer. Each draw is
+///  a POD packet in a thor::MemoryArena plus a 64 bit sort key:
+///		layer (8 bits) | texture (16 bits) | blend mode (8 bits) | sequence (32 bits)
+///  Sorting by key draws the layers in order, and groups the draws of a layer by
+///  state. The sequence number keeps the recording order among draws with equal state.
+/// Example usage:
+///		sf::Vertex* quad = commands.allocateVertices(6);
+///		...
+///		commands.draw(RenderLayer::World, quad, 6, sf::Triangles, &texture);
+///		commands.sort();
+///		backend.submit(commands);
+///		commands.clear();
+/// </summary>
+class RenderCommandBuffer
+{
+public:
+	struct Command
+	{
+		std::uint64_t key;
+		const DrawPacket* packet;
+	};
+
+	/// <summary>
+	/// @brief Returns storage for vertices that stays valid until clear().
+	/// </summary>
+	sf::Vertex* allocateVertices(std::size_t t_count);
+
+	/// <summary>
+	/// @brief Records a draw of vertices. The vertices must stay valid until clear(),
+	///  e.g. by allocating them with allocateVertices().
+	/// </summary>
+	void draw(RenderLayer t_layer, const sf::Vertex* t_vertices, std::size_t t_count, sf::PrimitiveType t_type,
+		const sf::Texture* t_texture, const sf::BlendMode& t_blendMode = sf::BlendAlpha);
+
+	/// <summary>
+	/// @brief Records a draw of an object that draws itself. It must stay alive until the buffer is submitted.
+	/// </summary>
+	void draw(RenderLayer t_layer, const sf::Drawable& t_drawable, const sf::Texture* t_texture,
+		const sf::BlendMode& t_blendMode = sf::BlendAlpha);
+
+	/// <summary>
+	/// @brief Orders the commands by their sort key.
+	/// </summary>
+	void sort();
+
+	/// <summary>
+	/// @brief Removes all commands and releases the frame memory, keeping the capacity.
+	/// The texture and blend mode tables are kept, so keys stay comparable across frames.
+	/// </summary>
+	void clear();
+
+	const std::vector<Command>& getCommands() const;
+
+	const std::vector<sf::BlendMode>& getBlendModes() const;
+
+	/// <summary>
+	/// @brief Returns the arena that holds this frame's packets and vertices.
+	/// </summary>
+	const thor::MemoryArena& getArena() const;
+
+private:
+	void record(RenderLayer t_layer, DrawPacket& t_packet, const sf::BlendMode& t_blendMode);
+
+	// Allocates t_count default-initialised objects from the arena, which never runs destructors.
+	template <typename T>
+	T* allocateArray(std::size_t t_count);
+
+	// Returns the small id of a texture or blend mode, registering it on first use.
+	std::uint16_t getTextureId(const sf::Texture* t_texture);
+	std::uint8_t getBlendModeId(const sf::BlendMode& t_blendMode);
+
+	thor::MemoryArena m_arena;
+	std::vector<Command> m_commands;
+	// Textures and blend modes seen so far; the index is the id used in sort keys.
+	std::vector<const sf::Texture*> m_textures;
+	std::vector<sf::BlendMode> m_blendModes;
+};
@@ -0,0 +1,36 @@
+#include "SimulationClock.h"
+
+#include <cassert>
+
+////////////////////////////////////////////////////////////
+sf::Time SystemClock::getElapsedTime() const
+{
+	return m_clock.getElapsedTime();
+}
+
+////////////////////////////////////////////////////////////
+sf::Time SimulationClock::getElapsedTime() const
+{
+	return m_elapsed;
+}
+
+////////////////////////////////////////////////////////////
+sf::Time SimulationClock::advance(sf::Time t_realStep)
+{
+	sf::Time step = t_realStep * m_timeScale;
+	m_elapsed += step;
+	return step;
+}
+
+////////////////////////////////////////////////////////////
+void SimulationClock::setTimeScale(float t_scale)
+{
+	assert(t_scale >= 0.0f);
+	m_timeScale = t_scale;
+}
+
+////////////////////////////////////////////////////////////
+float SimulationClock::getTimeScale() const
+{
+	return m_timeScale;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Time.hpp>
+
+/// <summary>
+/// @brief Interface for anything that can tell the current time.
+///
+/// Lets timers read either the OS clock or the game's simulated time,
+///  without knowing which one they are attached to.
+/// </summary>
+class ClockSource
+{
+public:
+	virtual ~ClockSource() = default;
+
+	/// <summary>
+	/// @brief Returns the time elapsed since the clock was created.
+	/// </summary>
+	virtual sf::Time getElapsedTime() const = 0;
+};
+
+/// <summary>
+/// @brief Clock source backed by the OS monotonic clock (sf::Clock).
+/// Every query is a system call, so prefer SimulationClock inside the update loop.
+/// </summary>
+class SystemClock : public ClockSource
+{
+public:
+	sf::Time getElapsedTime() const override;
+
+private:
+	sf::Clock m_clock;
+};
+
+/// <summary>
+/// @brief Clock source that only moves when the simulation is stepped.
+///
+/// Game::run() advances it once per fixed update, so every timer read during
+///  one step sees the same time and no OS clock is queried in the hot loop.
+/// The time scale stretches or compresses each step, e.g. a scale of 4
+///  runs the simulation four times faster for fast-forward benchmarking.
+/// </summary>
+class SimulationClock : public ClockSource
+{
+public:
+	sf::Time getElapsedTime() const override;
+
+	/// <summary>
+	/// @brief Advances the simulated time by one step.
+	/// </summary>
+	/// <param name="t_realStep">The unscaled duration of the step</param>
+	/// <returns>The scaled duration that was added to the simulated time.</returns>
+	sf::Time advance(sf::Time t_realStep);
+
+	/// <summary>
+	/// @brief Sets the factor applied to every subsequent step.
+	/// </summary>
+	/// <param name="t_scale">1 is real time, 0 pauses the simulation. Must not be negative.</param>
+	void setTimeScale(float t_scale);
+
+	float getTimeScale() const;
+
+private:
+	sf::Time m_elapsed;
+	float m_timeScale{ 1.0f };
+};
@@ -0,0 +1,201 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/// <summary>
+/// @brief Container with O(1) insertion, removal and lookup through stable handles.
+///
+/// Values are stored contiguously, so iterating over them is as fast as over a
+///  std::vector. Removal moves the last value into the hole, so the order of
+///  values is not preserved. Handles stay valid until their value is erased; a
+///  generation counter per slot detects handles to values that are gone, even
+///  when the slot has been reused.
+/// Example usage:
+///		SlotMap<Emitter> emitters;
+///		SlotMap<Emitter>::Handle h = emitters.insert(emitter);
+///		emitters.erase(h);
+/// </summary>
+template <typename T>
+class SlotMap
+{
+public:
+	/// <summary>
+	/// @brief Refers to a value stored in the slot map.
+	/// A default constructed handle refers to nothing.
+	/// </summary>
+	struct Handle
+	{
+		std::uint32_t index{ INVALID_INDEX };
+		std::uint32_t generation{ 0 };
+	};
+
+	/// <summary>
+	/// @brief Stores a value and returns the handle to it.
+	/// </summary>
+	Handle insert(T t_value);
+
+	/// <summary>
+	/// @brief Removes the value referred to by the handle.
+	/// </summary>
+	/// <returns>true if a value was removed, false if the handle was stale.</returns>
+	bool erase(Handle t_handle);
+
+	/// <summary>
+	/// @brief Removes the value at the given position in the contiguous storage.
+	/// The last value is moved into its place, so iterate backwards when erasing while iterating.
+	/// </summary>
+	void eraseAt(std::size_t t_position);
+
+	bool contains(Handle t_handle) const;
+
+	/// <summary>
+	/// @brief Returns the value referred to by the handle, or nullptr if the handle is stale.
+	/// </summary>
+	T* get(Handle t_handle);
+	const T* get(Handle t_handle) const;
+
+	/// <summary>
+	/// @brief Returns the handle of the value at the given position in the contiguous storage.
+	/// </summary>
+	Handle handleAt(std::size_t t_position) const;
+
+	void clear();
+
+	std::size_t size() const { return m_values.size(); }
+	bool empty() const { return m_values.empty(); }
+
+	T& operator[](std::size_t t_position) { return m_values[t_position]; }
+	const T& operator[](std::size_t t_position) const { return m_values[t_position]; }
+
+	typename std::vector<T>::iterator begin() { return m_values.begin(); }
+	typename std::vector<T>::iterator end() { return m_values.end(); }
+	typename std::vector<T>::const_iterator begin() const { return m_values.begin(); }
+	typename std::vector<T>::const_iterator end() const { return m_values.end(); }
+
+private:
+	static const std::uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+	struct Slot
+	{
+		// Position of the value in m_values while in use, next free slot otherwise.
+		std::uint32_t position;
+		std::uint32_t generation;
+	};
+
+	std::vector<T> m_values;
+	// Slot index of every value in m_values, used to patch slots when values move.
+	std::vector<std::uint32_t> m_valueSlots;
+	std::vector<Slot> m_slots;
+	std::uint32_t m_freeHead{ INVALID_INDEX };
+};
+
+////////////////////////////////////////////////////////////
+template <typename T>
+typename SlotMap<T>::Handle SlotMap<T>::insert(T t_value)
+{
+	std::uint32_t slotIndex;
+	if (m_freeHead != INVALID_INDEX)
+	{
+		slotIndex = m_freeHead;
+		m_freeHead = m_slots[slotIndex].position;
+	}
+	else
+	{
+		slotIndex = static_cast<std::uint32_t>(m_slots.size());
+		m_slots.push_back(Slot{ INVALID_INDEX, 0 });
+	}
+
+	m_slots[slotIndex].position = static_cast<std::uint32_t>(m_values.size());
+	m_values.push_back(std::move(t_value));
+	m_valueSlots.push_back(slotIndex);
+
+	Handle handle;
+	handle.index = slotIndex;
+	handle.generation = m_slots[slotIndex].generation;
+	return handle;
+}
+
+////////////////////////////////////////////////////////////
+template <typename T>
+bool SlotMap<T>::erase(Handle t_handle)
+{
+	if (!contains(t_handle))
+	{
+		return false;
+	}
+
+	eraseAt(m_slots[t_handle.index].position);
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void SlotMap<T>::eraseAt(std::size_t t_position)
+{
+	assert(t_position < m_values.size());
+
+	std::uint32_t slotIndex = m_valueSlots[t_position];
+	std::size_t last = m_values.size() - 1;
+
+	// Fill the hole with the last value and point its slot to the new position.
+	if (t_position != last)
+	{
+		m_values[t_position] = std::move(m_values[last]);
+		m_valueSlots[t_position] = m_valueSlots[last];
+		m_slots[m_valueSlots[t_position]].position = static_cast<std::uint32_t>(t_position);
+	}
+	m_values.pop_back();
+	m_valueSlots.pop_back();
+
+	// Invalidate outstanding handles and put the slot on the free list.
+	Slot& slot = m_slots[slotIndex];
+	++slot.generation;
+	slot.position = m_freeHead;
+	m_freeHead = slotIndex;
+}
+
+////////////////////////////////////////////////////////////
+template <typename T>
+bool SlotMap<T>::contains(Handle t_handle) const
+{
+	// Erasing bumps the generation, so a matching generation means the slot is in use.
+	return t_handle.index < m_slots.size()
+		&& m_slots[t_handle.index].generation == t_handle.generation;
+}
+
+////////////////////////////////////////////////////////////
+template <typename T>
+T* SlotMap<T>::get(Handle t_handle)
+{
+	return contains(t_handle) ? &m_values[m_slots[t_handle.index].position] : nullptr;
+}
+
+////////////////////////////////////////////////////////////
+template <typename T>
+const T* SlotMap<T>::get(Handle t_handle) const
+{
+	return contains(t_handle) ? &m_values[m_slots[t_handle.index].position] : nullptr;
+}
+
+////////////////////////////////////////////////////////////
+template <typename T>
+typename SlotMap<T>::Handle SlotMap<T>::handleAt(std::size_t t_position) const
+{
+	Handle handle;
+	handle.index = m_valueSlots[t_position];
+	handle.generation = m_slots[handle.index].generation;
+	return handle;
+}
+
+////////////////////////////////////////////////////////////
+template <typename T>
+void SlotMap<T>::clear()
+{
+	for (std::size_t i = m_values.size(); i > 0; --i)
+	{
+		eraseAt(i - 1);
+	}
+}
@@ -0,0 +1,557 @@
+#include "SoftwareRenderBackend.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <thread>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SOFTWARE_RENDER_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+	// x / 255, rounded, for x in [0, 255 * 255].
+	inline int div255(int t_value)
+	{
+		int rounded = t_value + 128;
+		return (rounded + (rounded >> 8)) >> 8;
+	}
+
+	inline std::uint8_t toChannel(float t_value)
+	{
+		return static_cast<std::uint8_t>(std::min(std::max(t_value, 0.0f), 255.0f) + 0.5f);
+	}
+
+	// Converts a coordinate to the first pixel whose centre is at or after it, clamped to [0, t_limit].
+	inline int firstPixelCenter(float t_coordinate, int t_limit)
+	{
+		float pixel = std::ceil(t_coordinate - 0.5f);
+		if (!(pixel > 0.0f))
+		{
+			return 0;
+		}
+		return pixel < t_limit ? static_cast<int>(pixel) : t_limit;
+	}
+
+	int blendFactor(sf::BlendMode::Factor t_factor, const std::uint8_t* t_source, const std::uint8_t* t_destination, int t_channel)
+	{
+		switch (t_factor)
+		{
+		case sf::BlendMode::Zero: return 0;
+		case sf::BlendMode::One: return 255;
+		case sf::BlendMode::SrcColor: return t_source[t_channel];
+		case sf::BlendMode::OneMinusSrcColor: return 255 - t_source[t_channel];
+		case sf::BlendMode::DstColor: return t_destination[t_channel];
+		case sf::BlendMode::OneMinusDstColor: return 255 - t_destination[t_channel];
+		case sf::BlendMode::SrcAlpha: return t_source[3];
+		case sf::BlendMode::OneMinusSrcAlpha: return 255 - t_source[3];
+		case sf::BlendMode::DstAlpha: return t_destination[3];
+		case sf::BlendMode::OneMinusDstAlpha: return 255 - t_destination[3];
+		}
+		return 0;
+	}
+
+	// Reference implementation of all blend modes, which the SSE2 path matches exactly.
+	void blendPixel(const sf::BlendMode& t_mode, const std::uint8_t* t_source, std::uint8_t* t_destination)
+	{
+		std::uint8_t result[4];
+		for (int channel = 0; channel < 4; ++channel)
+		{
+			bool alpha = channel == 3;
+			int source = div255(t_source[channel]
+				* blendFactor(alpha ? t_mode.alphaSrcFactor : t_mode.colorSrcFactor, t_source, t_destination, channel));
+			int destination = div255(t_destination[channel]
+				* blendFactor(alpha ? t_mode.alphaDstFactor : t_mode.colorDstFactor, t_source, t_destination, channel));
+
+			int value;
+			switch (alpha ? t_mode.alphaEquation : t_mode.colorEquation)
+			{
+			case sf::BlendMode::Subtract: value = source - destination; break;
+			case sf::BlendMode::ReverseSubtract: value = destination - source; break;
+			default: value = source + destination; break;
+			}
+			result[channel] = static_cast<std::uint8_t>(std::min(std::max(value, 0), 255));
+		}
+		std::memcpy(t_destination, result, 4);
+	}
+
+	// Expresses a factor as base + (sourceAlpha & plus) - (sourceAlpha & minus), if it can be.
+	bool splitFactor(sf::BlendMode::Factor t_factor, std::uint16_t& t_base, std::uint16_t& t_plus, std::uint16_t& t_minus)
+	{
+		t_base = 0;
+		t_plus = 0;
+		t_minus = 0;
+		switch (t_factor)
+		{
+		case sf::BlendMode::Zero: return true;
+		case sf::BlendMode::One: t_base = 255; return true;
+		case sf::BlendMode::SrcAlpha: t_plus = 0xFFFF; return true;
+		case sf::BlendMode::OneMinusSrcAlpha: t_base = 255; t_minus = 0xFFFF; return true;
+		default: return false;
+		}
+	}
+
+#ifdef SOFTWARE_RENDER_SSE2
+	// x / 255, rounded, in every 16 bit lane.
+	inline __m128i div255(__m128i t_value)
+	{
+		__m128i rounded = _mm_add_epi16(t_value, _mm_set1_epi16(128));
+		return _mm_srli_epi16(_mm_add_epi16(rounded, _mm_srli_epi16(rounded, 8)), 8);
+	}
+
+	// Blends two pixels that are unpacked to 16 bit lanes.
+	inline __m128i blendLanes(__m128i t_source, __m128i t_destination, const __m128i* t_factors)
+	{
+		__m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(t_source, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+		__m128i sourceFactor = _mm_sub_epi16(_mm_add_epi16(t_factors[0], _mm_and_si128(alpha, t_factors[1])),
+			_mm_and_si128(alpha, t_factors[2]));
+		__m128i destinationFactor = _mm_sub_epi16(_mm_add_epi16(t_factors[3], _mm_and_si128(alpha, t_factors[4])),
+			_mm_and_si128(alpha, t_factors[5]));
+		return _mm_add_epi16(div255(_mm_mullo_epi16(t_source, sourceFactor)),
+			div255(_mm_mullo_epi16(t_destination, destinationFactor)));
+	}
+#endif
+}
+
+////////////////////////////////////////////////////////////
+SoftwareRenderBackend::SoftwareRenderBackend(unsigned t_width, unsigned t_height)
+	: m_width(t_width)
+	, m_height(t_height)
+	, m_pixels(t_width * t_height * 4)
+{
+}
+
+////////////////////////////////////////////////////////////
+void SoftwareRenderBackend::setTexture(const sf::Texture* t_texture, const sf::Image& t_image)
+{
+	TextureData& texture = m_textures[t_texture];
+	texture.width = t_image.getSize().x;
+	texture.height = t_image.getSize().y;
+	texture.pixels.assign(t_image.getPixelsPtr(), t_image.getPixelsPtr() + texture.width * texture.height * 4);
+}
+
+////////////////////////////////////////////////////////////
+void SoftwareRenderBackend::setThreadCount(unsigned t_threadCount)
+{
+	m_threadCount = std::max(t_threadCount, 1u);
+}
+
+////////////////////////////////////////////////////////////
+void SoftwareRenderBackend::clear(sf::Color t_color)
+{
+	const std::uint8_t color[4] = { t_color.r, t_color.g, t_color.b, t_color.a };
+	for (std::size_t i = 0; i < m_pixels.size(); i += 4)
+	{
+		std::memcpy(&m_pixels[i], color, 4);
+	}
+}
+
+////////////////////////////////////////////////////////////
+void SoftwareRenderBackend::submit(const RenderCommandBuffer& t_commands)
+{
+	m_drawCallCount = 0;
+	m_skippedDrawCount = 0;
+	for (const RenderCommandBuffer::Command& command : t_commands.getCommands())
+	{
+		const DrawPacket& packet = *command.packet;
+		if (packet.drawable)
+		{
+			++m_skippedDrawCount;
+			continue;
+		}
+		assemble(packet.vertices, packet.vertexCount, packet.primitiveType, packet.texture,
+			t_commands.getBlendModes()[packet.blendMode]);
+	}
+	rasterize();
+}
+
+////////////////////////////////////////////////////////////
+void SoftwareRenderBackend::draw(const sf::Vertex* t_vertices, std::size_t t_count, sf::PrimitiveType t_type,
+	const sf::Texture* t_texture, const sf::BlendMode& t_blendMode)
+{
+	m_drawCallCount = 0;
+	m_skippedDrawCount = 0;
+	assemble(t_vertices, t_count, t_type, t_texture, t_blendMode);
+	rasterize();
+}
+
+////////////////////////////////////////////////////////////
+void SoftwareRenderBackend::draw(const sf::VertexArray& t_vertices, const sf::Texture* t_texture, const sf::BlendMode& t_blendMode)
+{
+	if (t_vertices.getVertexCount() > 0)
+	{
+		draw(&t_vertices[0], t_vertices.getVertexCount(), t_vertices.getPrimitiveType(), t_texture, t_blendMode);
+	}
+}
+
+////////////////////////////////////////////////////////////
+sf::Vector2u SoftwareRenderBackend::getSize() const
+{
+	return sf::Vector2u(m_width, m_height);
+}
+
+////////////////////////////////////////////////////////////
+const std::uint8_t* SoftwareRenderBackend::getPixels() const
+{
+	return m_pixels.data();
+}
+
+////////////////////////////////////////////////////////////
+sf::Image SoftwareRenderBackend::copyToImage() const
+{
+	sf::Image image;
+	image.create(m_width, m_height, m_pixels.data());
+	return image;
+}
+
+////////////////////////////////////////////////////////////
+std::uint64_t SoftwareRenderBackend::getFilledPixelCount() const
+{
+	return m_filledPixelCount;
+}
+
+////////////////////////////////////////////////////////////
+std::size_t SoftwareRenderBackend::getSkippedDrawCount() const
+{
+	return m_skippedDrawCount;
+}
+
+////////////////////////////////////////////////////////////
+std::size_t SoftwareRenderBackend::countDifferentPixels(const sf::Image& t_first, const sf::Image& t_second, std::uint8_t t_tolerance)
+{
+	sf::Vector2u size = t_first.getSize();
+	if (size != t_second.getSize())
+	{
+		sf::Vector2u other = t_second.getSize();
+		return std::max(size.x * size.y, other.x * other.y);
+	}
+
+	const std::uint8_t* first = t_first.getPixelsPtr();
+	const std::uint8_t* second = t_second.getPixelsPtr();
+	std::size_t different = 0;
+	for (std::size_t i = 0; i < std::size_t(size.x) * size.y * 4; i += 4)
+	{
+		for (std::size_t channel = 0; channel < 4; ++channel)
+		{
+			if (std::abs(first[i + channel] - second[i + channel]) > t_tolerance)
+			{
+				++different;
+				break;
+			}
+		}
+	}
+	return different;
+}
+
+////////////////////////////////////////////////////////////
+void SoftwareRenderBackend::assemble(const sf::Vertex* t_vertices, std::size_t t_count, sf::PrimitiveType t_type,
+	const sf::Texture* t_texture, const sf::BlendMode& t_blendMode)
+{
+	const TextureData* texture = nullptr;
+	if (t_texture)
+	{
+		auto found = m_textures.find(t_texture);
+		if (found == m_textures.end())
+		{
+			++m_skippedDrawCount;
+			return;
+		}
+		texture = &found->second;
+	}
+	std::uint32_t blendState = getBlendState(t_blendMode);
+
+	switch (t_type)
+	{
+	case sf::Triangles:
+		for (std::size_t i = 2; i < t_count; i += 3)
+		{
+			addTriangle(t_vertices[i - 2], t_vertices[i - 1], t_vertices[i], texture, blendState);
+		}
+		break;
+	case sf::TriangleStrip:
+		for (std::size_t i = 2; i < t_count; ++i)
+		{
+			addTriangle(t_vertices[i - 2], t_vertices[i - 1], t_vertices[i], texture, blendState);
+		}
+		break;
+	case sf::TriangleFan:
+		for (std::size_t i = 2; i < t_count; ++i)
+		{
+			addTriangle(t_vertices[0], t_vertices[i - 1], t_vertices[i], texture, blendState);
+		}
+		break;
+	case sf::Quads:
+		for (std::size_t i = 3; i < t_count; i += 4)
+		{
+			addTriangle(t_vertices[i - 3], t_vertices[i - 2], t_vertices[i - 1], texture, blendState);
+			addTriangle(t_vertices[i - 3], t_vertices[i - 1], t_vertices[i], texture, blendState);
+		}
+		break;
+	default:
+		++m_skippedDrawCount;
+		return;
+	}
+	++m_drawCallCount;
+}
+
+////////////////////////////////////////////////////////////
+void SoftwareRenderBackend::addTriangle(const sf::Vertex& t_first, const sf::Vertex& t_second, const sf::Vertex& t_third,
+	const TextureData* t_texture, std::uint32_t t_blendState)
+{
+	// Sort top to bottom, then left to right, so that triangles sharing an edge compute it identically.
+	const sf::Vertex* vertices[3] = { &t_first, &t_second, &t_third };
+	std::sort(vertices, vertices + 3, [](const sf::Vertex* t_lhs, const sf::Vertex* t_rhs)
+	{
+		return t_lhs->position.y < t_rhs->position.y
+			|| (t_lhs->position.y == t_rhs->position.y && t_lhs->position.x < t_rhs->position.x);
+	});
+
+	sf::Vector2f p0 = vertices[0]->position;
+	sf::Vector2f p1 = vertices[1]->position;
+	sf::Vector2f p2 = vertices[2]->position;
+	float area = (p1.x - p0.x) * (p2.y - p0.y) - (p2.x - p0.x) * (p1.y - p0.y);
+	if (area == 0.0f)
+	{
+		return;
+	}
+
+	Triangle triangle;
+	triangle.firstRow = firstPixelCenter(p0.y, static_cast<int>(m_height));
+	triangle.endRow = firstPixelCenter(p2.y, static_cast<int>(m_height));
+	if (triangle.firstRow >= triangle.endRow)
+	{
+		return;
+	}
+
+	triangle.corners[0] = p0;
+	triangle.corners[1] = p1;
+	triangle.corners[2] = p2;
+	triangle.slopes[0] = p1.y > p0.y ? (p1.x - p0.x) / (p1.y - p0.y) : 0.0f;
+	triangle.slopes[1] = p2.y > p1.y ? (p2.x - p1.x) / (p2.y - p1.y) : 0.0f;
+	triangle.slopes[2] = (p2.x - p0.x) / (p2.y - p0.y);
+
+	// Plane equations of the vertex attributes.
+	float values[3][6];
+	for (int i = 0; i < 3; ++i)
+	{
+		const sf::Vertex& vertex = *vertices[i];
+		values[i][0] = vertex.color.r;
+		values[i][1] = vertex.color.g;
+		values[i][2] = vertex.color.b;
+		values[i][3] = vertex.color.a;
+		values[i][4] = vertex.texCoords.x;
+		values[i][5] = vertex.texCoords.y;
+	}
+	for (int a = 0; a < 6; ++a)
+	{
+		float d1 = values[1][a] - values[0][a];
+		float d2 = values[2][a] - values[0][a];
+		triangle.attributes[a] = values[0][a];
+		triangle.gradientX[a] = (d1 * (p2.y - p0.y) - d2 * (p1.y - p0.y)) / area;
+		triangle.gradientY[a] = (d2 * (p1.x - p0.x) - d1 * (p2.x - p0.x)) / area;
+	}
+
+	triangle.flatColor = !t_texture
+		&& vertices[0]->color == vertices[1]->color && vertices[0]->color == vertices[2]->color;
+	triangle.texture = t_texture;
+	triangle.blendState = t_blendState;
+	m_triangles.push_back(triangle);
+}
+
+////////////////////////////////////////////////////////////
+std::uint32_t SoftwareRenderBackend::getBlendState(const sf::BlendMode& t_blendMode)
+{
+	for (std::uint32_t i = 0; i < m_blendStates.size(); ++i)
+	{
+		if (m_blendStates[i].mode == t_blendMode)
+		{
+			return i;
+		}
+	}
+
+	BlendState state;
+	state.mode = t_blendMode;
+	state.simd = t_blendMode.colorEquation == sf::BlendMode::Add && t_blendMode.alphaEquation == sf::BlendMode::Add;
+	for (int lane = 0; lane < 8; ++lane)
+	{
+		bool alpha = lane % 4 == 3;
+		state.simd = splitFactor(alpha ? t_blendMode.alphaSrcFactor : t_blendMode.colorSrcFactor,
+			state.srcBase[lane], state.srcPlus[lane], state.srcMinus[lane]) && state.simd;
+		state.simd = splitFactor(alpha ? t_blendMode.alphaDstFactor : t_blendMode.colorDstFactor,
+			state.dstBase[lane], state.dstPlus[lane], state.dstMinus[lane]) && state.simd;
+	}
+	m_blendStates.push_back(state);
+	return static_cast<std::uint32_t>(m_blendStates.size() - 1);
+}
+
+////////////////////////////////////////////////////////////
+void SoftwareRenderBackend::rasterize()
+{
+	m_filledPixelCount = 0;
+	int tileCount = (static_cast<int>(m_height) + TILE_ROWS - 1) / TILE_ROWS;
+	unsigned threadCount = std::min(m_threadCount, static_cast<unsigned>(std::max(tileCount, 1)));
+
+	if (threadCount <= 1)
+	{
+		std::vector<std::uint8_t> span(m_width * 4);
+		m_filledPixelCount = rasterizeRows(0, static_cast<int>(m_height), span.data());
+	}
+	else
+	{
+		// Thread i rasterizes the tiles i, i + threadCount, ... so that dense areas are shared out.
+		std::vector<std::uint64_t> filled(threadCount, 0);
+		auto rasterizeTiles = [&](unsigned t_thread)
+		{
+			std::vector<std::uint8_t> span(m_width * 4);
+			for (int tile = static_cast<int>(t_thread); tile < tileCount; tile += static_cast<int>(threadCount))
+			{
+				int firstRow = tile * TILE_ROWS;
+				filled[t_thread] += rasterizeRows(firstRow, std::min(firstRow + TILE_ROWS, static_cast<int>(m_height)), span.data());
+			}
+		};
+
+		std::vector<std::thread> threads;
+		for (unsigned i = 1; i < threadCount; ++i)
+		{
+			threads.emplace_back(rasterizeTiles, i);
+		}
+		rasterizeTiles(0);
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+
+		for (std::uint64_t count : filled)
+		{
+			m_filledPixelCount += count;
+		}
+	}
+
+	m_triangles.clear();
+}
+
+////////////////////////////////////////////////////////////
+std::uint64_t SoftwareRenderBackend::rasterizeRows(int t_firstRow, int t_endRow, std::uint8_t* t_span)
+{
+	std::uint64_t filled = 0;
+	std::uint8_t* pixels = m_pixels.data();
+	const int width = static_cast<int>(m_width);
+
+	for (const Triangle& triangle : m_triangles)
+	{
+		int firstRow = std::max(triangle.firstRow, t_firstRow);
+		int endRow = std::min(triangle.endRow, t_endRow);
+		const sf::Vector2f* corners = triangle.corners;
+
+		for (int y = firstRow; y < endRow; ++y)
+		{
+			// Intersect the row's centre line with the long edge and with the short edge on the same height.
+			float center = y + 0.5f;
+			float longEdge = corners[0].x + (center - corners[0].y) * triangle.slopes[2];
+			float shortEdge = center < corners[1].y
+				? corners[0].x + (center - corners[0].y) * triangle.slopes[0]
+				: corners[1].x + (center - corners[1].y) * triangle.slopes[1];
+
+			int firstPixel = firstPixelCenter(std::min(longEdge, shortEdge), width);
+			int endPixel = firstPixelCenter(std::max(longEdge, shortEdge), width);
+			if (firstPixel >= endPixel)
+			{
+				continue;
+			}
+
+			int count = endPixel - firstPixel;
+			shadeSpan(triangle, firstPixel, y, count, t_span);
+			blendSpan(m_blendStates[triangle.blendState], t_span, pixels + (std::size_t(y) * m_width + firstPixel) * 4, count);
+			filled += count;
+		}
+	}
+	return filled;
+}
+
+////////////////////////////////////////////////////////////
+void SoftwareRenderBackend::shadeSpan(const Triangle& t_triangle, int t_x, int t_y, int t_count, std::uint8_t* t_span) const
+{
+	float dx = t_x + 0.5f - t_triangle.corners[0].x;
+	float dy = t_y + 0.5f - t_triangle.corners[0].y;
+	float values[6];
+	for (int a = 0; a < 6; ++a)
+	{
+		values[a] = t_triangle.attributes[a] + t_triangle.gradientX[a] * dx + t_triangle.gradientY[a] * dy;
+	}
+
+	if (t_triangle.flatColor)
+	{
+		// The gradients are zero, so the corner colour is exact.
+		const std::uint8_t color[4] = { toChannel(values[0]), toChannel(values[1]), toChannel(values[2]), toChannel(values[3]) };
+		for (int i = 0; i < t_count; ++i)
+		{
+			std::memcpy(t_span + i * 4, color, 4);
+		}
+		return;
+	}
+
+	const TextureData* texture = t_triangle.texture;
+	for (int i = 0; i < t_count; ++i)
+	{
+		std::uint8_t* pixel = t_span + i * 4;
+		for (int channel = 0; channel < 4; ++channel)
+		{
+			pixel[channel] = toChannel(values[channel]);
+		}
+
+		if (texture)
+		{
+			// Nearest sampling, clamped to the edge like a texture without repeat.
+			int u = static_cast<int>(std::floor(values[4]));
+			int v = static_cast<int>(std::floor(values[5]));
+			u = std::min(std::max(u, 0), static_cast<int>(texture->width) - 1);
+			v = std::min(std::max(v, 0), static_cast<int>(texture->height) - 1);
+			const std::uint8_t* texel = &texture->pixels[(std::size_t(v) * texture->width + u) * 4];
+			for (int channel = 0; channel < 4; ++channel)
+			{
+				pixel[channel] = static_cast<std::uint8_t>(div255(pixel[channel] * texel[channel]));
+			}
+		}
+
+		for (int a = 0; a < 6; ++a)
+		{
+			values[a] += t_triangle.gradientX[a];
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+void SoftwareRenderBackend::blendSpan(const BlendState& t_blend, const std::uint8_t* t_source, std::uint8_t* t_destination, int t_count)
+{
+	int i = 0;
+#ifdef SOFTWARE_RENDER_SSE2
+	if (t_blend.simd)
+	{
+		const __m128i factors[6] = {
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(t_blend.srcBase)),
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(t_blend.srcPlus)),
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(t_blend.srcMinus)),
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(t_blend.dstBase)),
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(t_blend.dstPlus)),
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(t_blend.dstMinus))
+		};
+		const __m128i zero = _mm_setzero_si128();
+
+		for (; i + 4 <= t_count; i += 4)
+		{
+			__m128i source = _mm_loadu_si128(reinterpret_cast<const __m128i*>(t_source + i * 4));
+			__m128i destination = _mm_loadu_si128(reinterpret_cast<const __m128i*>(t_destination + i * 4));
+			__m128i low = blendLanes(_mm_unpacklo_epi8(source, zero), _mm_unpacklo_epi8(destination, zero), factors);
+			__m128i high = blendLanes(_mm_unpackhi_epi8(source, zero), _mm_unpackhi_epi8(destination, zero), factors);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(t_destination + i * 4), _mm_packus_epi16(low, high));
+		}
+	}
+#endif
+
+	for (; i < t_count; ++i)
+	{
+		blendPixel(t_blend.mode, t_source + i * 4, t_destination + i * 4);
+	}
+}
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "RenderBackend.h"
+
+/// <summary>
+/// @brief Rasterizes render commands on the CPU into an RGBA framebuffer.
+///
+/// Meant for machines without a GPU: regression tests against golden images, and
+///  benchmarks of the fill cost. It supports the subset of SFML drawing the game
+///  uses: triangles, triangle strips and fans and quads with vertex colours, nearest
+///  texture sampling and all of SFML's blend modes. Sprites and convex shapes are
+///  drawn by recording them with a SpriteBatch. Vertex positions are taken as pixels,
+///  as with the default view. Points, lines and commands that draw an sf::Drawable
+///  are skipped.
+/// A pixel is filled when its centre is inside a triangle, with a top-left rule, so
+///  triangles that share an edge never fill a pixel twice. Each row is shaded into a
+///  span buffer first and then blended into the framebuffer, four pixels at a time
+///  with SSE2 for the usual alpha, additive and opaque blend modes.
+/// Textures live on the GPU, so their pixels have to be registered with setTexture().
+/// With setThreadCount() the framebuffer is split into tiles of full rows, which the
+///  threads take turns to rasterize. Tiles never share pixels and every tile draws
+///  the triangles in order, so the result is the same for any thread count.
+/// Example usage:
+///		SoftwareRenderBackend backend(800, 600);
+///		backend.setTexture(&atlas.getTexture(), atlas.getImage());
+///		backend.clear();
+///		backend.submit(commands);
+///		backend.copyToImage().saveToFile("frame.png");
+/// </summary>
+class SoftwareRenderBackend : public RenderBackend
+{
+public:
+	SoftwareRenderBackend(unsigned t_width, unsigned t_height);
+
+	/// <summary>
+	/// @brief Registers the pixels draws with the given texture sample from.
+	/// Draws with a texture that was not registered are skipped.
+	/// </summary>
+	void setTexture(const sf::Texture* t_texture, const sf::Image& t_image);
+
+	/// <summary>
+	/// @brief Sets the number of threads that rasterize in parallel, 1 by default.
+	/// </summary>
+	void setThreadCount(unsigned t_threadCount);
+
+	void clear(sf::Color t_color = sf::Color::Black);
+
+	void submit(const RenderCommandBuffer& t_commands) override;
+
+	/// <summary>
+	/// @brief Rasterizes vertices immediately, without a command buffer.
+	/// </summary>
+	void draw(const sf::Vertex* t_vertices, std::size_t t_count, sf::PrimitiveType t_type,
+		const sf::Texture* t_texture, const sf::BlendMode& t_blendMode = sf::BlendAlpha);
+
+	void draw(const sf::VertexArray& t_vertices, const sf::Texture* t_texture,
+		const sf::BlendMode& t_blendMode = sf::BlendAlpha);
+
+	sf::Vector2u getSize() const;
+
+	/// <summary>
+	/// @brief Returns the framebuffer, as rows of RGBA bytes from top to bottom.
+	/// </summary>
+	const std::uint8_t* getPixels() const;
+
+	sf::Image copyToImage() const;
+
+	/// <summary>
+	/// @brief Returns the number of pixels shaded by the last submit() or draw().
+	/// Pixels are counted once per triangle covering them, so this measures overdraw too.
+	/// </summary>
+	std::uint64_t getFilledPixelCount() const;
+
+	/// <summary>
+	/// @brief Returns the number of draws the last submit() or draw() skipped as unsupported.
+	/// </summary>
+	std::size_t getSkippedDrawCount() const;
+
+	/// <summary>
+	/// @brief Compares two images, e.g. a rendered frame and its golden image.
+	/// </summary>
+	/// <param name="t_tolerance">The largest difference of a channel that still counts as equal</param>
+	/// <returns>The number of differing pixels; all pixels of the larger image if the sizes differ.</returns>
+	static std::size_t countDifferentPixels(const sf::Image& t_first, const sf::Image& t_second, std::uint8_t t_tolerance = 0);
+
+private:
+	// Texels of a registered texture.
+	struct TextureData
+	{
+		unsigned width;
+		unsigned height;
+		std::vector<std::uint8_t> pixels;
+	};
+
+	// A blend mode, with per channel factors prepared for the SSE2 path.
+	struct BlendState
+	{
+		sf::BlendMode mode;
+		// True if the factors only depend on the source alpha and both equations add.
+		bool simd;
+		// Factor per channel = base + (sourceAlpha & plus) - (sourceAlpha & minus),
+		//  for two pixels of 16 bit lanes.
+		std::uint16_t srcBase[8];
+		std::uint16_t srcPlus[8];
+		std::uint16_t srcMinus[8];
+		std::uint16_t dstBase[8];
+		std::uint16_t dstPlus[8];
+		std::uint16_t dstMinus[8];
+	};
+
+	// A triangle set up for rasterization.
+	struct Triangle
+	{
+		// Corners sorted from top to bottom.
+		sf::Vector2f corners[3];
+		// Inverse slopes of the edges 0-1, 1-2 and 0-2.
+		float slopes[3];
+		// Red, green, blue, alpha, u and v at corner 0, and their change per pixel in x and y.
+		float attributes[6];
+		float gradientX[6];
+		float gradientY[6];
+		// Rows with their centre inside the triangle.
+		int firstRow;
+		int endRow;
+		bool flatColor;
+		const TextureData* texture;
+		std::uint32_t blendState;
+	};
+
+	// Splits primitives into triangles and appends them to m_triangles.
+	void assemble(const sf::Vertex* t_vertices, std::size_t t_count, sf::PrimitiveType t_type,
+		const sf::Texture* t_texture, const sf::BlendMode& t_blendMode);
+
+	void addTriangle(const sf::Vertex& t_first, const sf::Vertex& t_second, const sf::Vertex& t_third,
+		const TextureData* t_texture, std::uint32_t t_blendState);
+
+	std::uint32_t getBlendState(const sf::BlendMode& t_blendMode);
+
+	// Rasterizes all assembled triangles, tile by tile on all threads, and removes them.
+	void rasterize();
+
+	// Rasterizes the parts of all triangles within [t_firstRow, t_endRow); returns the number of pixels filled.
+	// t_span is scratch memory for one row.
+	std::uint64_t rasterizeRows(int t_firstRow, int t_endRow, std::uint8_t* t_span);
+
+	// Computes the colours of a row of pixels of a triangle into t_span.
+	void shadeSpan(const Triangle& t_triangle, int t_x, int t_y, int t_count, std::uint8_t* t_span) const;
+
+	// Blends a row of source pixels into the framebuffer.
+	static void blendSpan(const BlendState& t_blend, const std::uint8_t* t_source, std::uint8_t* t_destination, int t_count);
+
+	// Rows per tile when rasterizing on several threads.
+	static const int TILE_ROWS{ 32 };
+
+	unsigned m_width;
+	unsigned m_height;
+	std::vector<std::uint8_t> m_pixels;
+
+	std::map<const sf::Texture*, TextureData> m_textures;
+	std::vector<BlendState> m_blendStates;
+	std::vector<Triangle> m_triangles;
+	unsigned m_threadCount{ 1 };
+
+	std::uint64_t m_filledPixelCount{ 0 };
+	std::size_t m_skippedDrawCount{ 0 };
+};
@@ -0,0 +1,172 @@
+#include "SpriteBatch.h"
+
+#include <algorithm>
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::setWhitePixel(const sf::Texture* t_texture, sf::Vector2f t_texCoords)
+{
+	m_whiteTexture = t_texture;
+	m_whiteTexCoords = t_texCoords;
+}
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::draw(const sf::Sprite& t_sprite, const sf::BlendMode& t_blendMode)
+{
+	// Same quad as sf::Sprite, split into two triangles.
+	sf::FloatRect bounds = t_sprite.getLocalBounds();
+	sf::IntRect rect = t_sprite.getTextureRect();
+	const sf::Transform& transform = t_sprite.getTransform();
+	sf::Color color = t_sprite.getColor();
+
+	float left = static_cast<float>(rect.left);
+	float right = left + rect.width;
+	float top = static_cast<float>(rect.top);
+	float bottom = top + rect.height;
+
+	sf::Vertex corners[4] =
+	{
+		sf::Vertex(transform.transformPoint(0, 0), color, sf::Vector2f(left, top)),
+		sf::Vertex(transform.transformPoint(bounds.width, 0), color, sf::Vector2f(right, top)),
+		sf::Vertex(transform.transformPoint(bounds.width, bounds.height), color, sf::Vector2f(right, bottom)),
+		sf::Vertex(transform.transformPoint(0, bounds.height), color, sf::Vector2f(left, bottom))
+	};
+
+	sf::Vertex* vertices = append(6, t_sprite.getTexture(), t_blendMode);
+	vertices[0] = corners[0];
+	vertices[1] = corners[1];
+	vertices[2] = corners[2];
+	vertices[3] = corners[0];
+	vertices[4] = corners[2];
+	vertices[5] = corners[3];
+}
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::draw(const sf::Shape& t_shape, const sf::BlendMode& t_blendMode)
+{
+	std::size_t pointCount = t_shape.getPointCount();
+	if (pointCount < 3)
+	{
+		return;
+	}
+
+	const sf::Transform& transform = t_shape.getTransform();
+	sf::Color color = t_shape.getFillColor();
+	const sf::Texture* texture = t_shape.getTexture();
+
+	// sf::Shape stretches its texture rect over the bounding box of its points.
+	sf::Vector2f firstPoint = t_shape.getPoint(0);
+	sf::FloatRect inside(firstPoint.x, firstPoint.y, 0, 0);
+	float right = inside.left;
+	float bottom = inside.top;
+	for (std::size_t i = 1; i < pointCount; ++i)
+	{
+		sf::Vector2f point = t_shape.getPoint(i);
+		inside.left = std::min(inside.left, point.x);
+		inside.top = std::min(inside.top, point.y);
+		right = std::max(right, point.x);
+		bottom = std::max(bottom, point.y);
+	}
+	inside.width = right - inside.left;
+	inside.height = bottom - inside.top;
+
+	sf::IntRect rect = t_shape.getTextureRect();
+	auto makeVertex = [&](sf::Vector2f t_point)
+	{
+		sf::Vector2f texCoords = m_whiteTexCoords;
+		if (texture)
+		{
+			float x = inside.width > 0 ? (t_point.x - inside.left) / inside.width : 0;
+			float y = inside.height > 0 ? (t_point.y - inside.top) / inside.height : 0;
+			texCoords = sf::Vector2f(rect.left + rect.width * x, rect.top + rect.height * y);
+		}
+		return sf::Vertex(transform.transformPoint(t_point), color, texCoords);
+	};
+
+	// Fan around the first point, which is fine for convex shapes.
+	sf::Vertex* vertices = append(3 * (pointCount - 2), texture ? texture : m_whiteTexture, t_blendMode);
+	sf::Vertex first = makeVertex(t_shape.getPoint(0));
+	sf::Vertex previous = makeVertex(t_shape.getPoint(1));
+	for (std::size_t i = 2; i < pointCount; ++i)
+	{
+		sf::Vertex current = makeVertex(t_shape.getPoint(i));
+		*vertices++ = first;
+		*vertices++ = previous;
+		*vertices++ = current;
+		previous = current;
+	}
+}
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::draw(const thor::Arrow& t_arrow, const sf::BlendMode& t_blendMode)
+{
+	// The geometry comes from thor::ArrowBatch; only the white texture coordinates are added here.
+	m_arrows.clear();
+	m_arrows.addArrow(t_arrow);
+	const sf::VertexArray& arrowVertices = m_arrows.getVertices();
+	std::size_t count = arrowVertices.getVertexCount();
+
+	sf::Vertex* vertices = append(count, m_whiteTexture, t_blendMode);
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		vertices[i] = arrowVertices[i];
+		vertices[i].texCoords = m_whiteTexCoords;
+	}
+}
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::drawTriangles(const sf::Vertex* t_vertices, std::size_t t_count, const sf::Texture* t_texture,
+	const sf::BlendMode& t_blendMode)
+{
+	std::copy(t_vertices, t_vertices + t_count, append(t_count, t_texture, t_blendMode));
+}
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::flush(sf::RenderTarget& t_target)
+{
+	m_drawCallCount = 0;
+	for (const Batch& batch : m_batches)
+	{
+		sf::RenderStates states(batch.blendMode);
+		states.texture = batch.texture;
+		t_target.draw(&m_vertices[batch.first], batch.count, sf::Triangles, states);
+		++m_drawCallCount;
+	}
+
+	// Keep the capacity for the next frame.
+	m_vertices.clear();
+	m_batches.clear();
+}
+
+////////////////////////////////////////////////////////////
+void SpriteBatch::record(RenderCommandBuffer& t_commands, RenderLayer t_layer)
+{
+	for (const Batch& batch : m_batches)
+	{
+		sf::Vertex* vertices = t_commands.allocateVertices(batch.count);
+		std::copy(m_vertices.begin() + batch.first, m_vertices.begin() + batch.first + batch.count, vertices);
+		t_commands.draw(t_layer, vertices, batch.count, sf::Triangles, batch.texture, batch.blendMode);
+	}
+	m_drawCallCount = static_cast<unsigned>(m_batches.size());
+
+	m_vertices.clear();
+	m_batches.clear();
+}
+
+////////////////////////////////////////////////////////////
+unsigned SpriteBatch::getDrawCallCount() const
+{
+	return m_drawCallCount;
+}
+
+////////////////////////////////////////////////////////////
+sf::Vertex* SpriteBatch::append(std::size_t t_count, const sf::Texture* t_texture, const sf::BlendMode& t_blendMode)
+{
+	if (m_batches.empty() || m_batches.back().texture != t_texture || m_batches.back().blendMode != t_blendMode)
+	{
+		m_batches.push_back(Batch{ t_texture, t_blendMode, m_vertices.size(), 0 });
+	}
+
+	m_batches.back().count += t_count;
+	m_vertices.resize(m_vertices.size() + t_count);
+	return &m_vertices[m_vertices.size() - t_count];
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <Thor/Shapes/Arrow.hpp>
+#include <Thor/Shapes/ArrowBatch.hpp>
+
+#include <vector>
+
+#include "RenderCommandBuffer.h"
+
+/// <summary>
+/// @brief Collects sprites, shapes and arrows into as few draw calls as possible.
+///
+/// Every sf::Drawable issues at least one draw call, and a thor::Arrow issues two.
+///  The batch instead converts everything into triangles in one vertex stream, and
+///  only starts a new draw call when the texture or blend mode changes. Untextured
+///  geometry samples a white pixel of a texture set with setWhitePixel(), so that it
+///  can share the draw call of textured sprites, e.g. from a texture atlas.
+/// Draw order is preserved.
+/// Example usage:
+///		batch.draw(sprite);
+///		batch.draw(arrow);
+///		batch.flush(window);
+///		std::cout << batch.getDrawCallCount();
+/// </summary>
+class SpriteBatch
+{
+public:
+	/// <summary>
+	/// @brief Lets untextured geometry sample the given texture coordinates instead of using no texture.
+	/// </summary>
+	/// <param name="t_texture">Texture with a white area, typically the texture atlas</param>
+	/// <param name="t_texCoords">Texture coordinates inside the white area</param>
+	void setWhitePixel(const sf::Texture* t_texture, sf::Vector2f t_texCoords);
+
+	void draw(const sf::Sprite& t_sprite, const sf::BlendMode& t_blendMode = sf::BlendAlpha);
+
+	/// <summary>
+	/// @brief Adds the fill of a convex shape; outlines are not supported.
+	/// </summary>
+	void draw(const sf::Shape& t_shape, const sf::BlendMode& t_blendMode = sf::BlendAlpha);
+
+	/// <summary>
+	/// @brief Adds an arrow with the same geometry thor::Arrow draws.
+	/// </summary>
+	void draw(const thor::Arrow& t_arrow, const sf::BlendMode& t_blendMode = sf::BlendAlpha);
+
+	/// <summary>
+	/// @brief Adds arbitrary triangles, in world coordinates.
+	/// </summary>
+	void drawTriangles(const sf::Vertex* t_vertices, std::size_t t_count, const sf::Texture* t_texture,
+		const sf::BlendMode& t_blendMode = sf::BlendAlpha);
+
+	/// <summary>
+	/// @brief Draws everything collected since the last flush, and empties the batch.
+	/// </summary>
+	void flush(sf::RenderTarget& t_target);
+
+	/// <summary>
+	/// @brief Records everything collected since the last flush as draw commands, and empties the batch.
+	/// The vertices are copied into the command buffer's frame memory.
+	/// </summary>
+	void record(RenderCommandBuffer& t_commands, RenderLayer t_layer);
+
+	/// <summary>
+	/// @brief Returns the number of draw calls issued by the last flush() or record().
+	/// </summary>
+	unsigned getDrawCallCount() const;
+
+private:
+	// A run of vertices that is drawn with one call.
+	struct Batch
+	{
+		const sf::Texture* texture;
+		sf::BlendMode blendMode;
+		std::size_t first;
+		std::size_t count;
+	};
+
+	// Makes room for the given number of vertices in a batch with matching state and returns the first one.
+	sf::Vertex* append(std::size_t t_count, const sf::Texture* t_texture, const sf::BlendMode& t_blendMode);
+
+	std::vector<sf::Vertex> m_vertices;
+	std::vector<Batch> m_batches;
+	unsigned m_drawCallCount{ 0 };
+	// Builds the triangles of one arrow at a time, so arrows have a single implementation.
+	thor::ArrowBatch m_arrows;
+
+	const sf::Texture* m_whiteTexture{ nullptr };
+	sf::Vector2f m_whiteTexCoords;
+};
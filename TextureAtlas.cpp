@@ -0,0 +1,213 @@
+#include "TextureAtlas.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+////////////////////////////////////////////////////////////
+SkylinePacker::SkylinePacker(unsigned t_width, unsigned t_height)
+	: m_width(t_width)
+	, m_height(t_height)
+{
+	m_skyline.push_back(Segment{ 0, 0, t_width });
+}
+
+////////////////////////////////////////////////////////////
+bool SkylinePacker::insert(unsigned t_width, unsigned t_height, sf::Vector2u& t_position)
+{
+	// Bottom-left: lowest top edge wins, ties go to the narrower segment.
+	std::size_t bestIndex = m_skyline.size();
+	unsigned bestTop = 0;
+	unsigned bestWidth = 0;
+	for (std::size_t i = 0; i < m_skyline.size(); ++i)
+	{
+		unsigned y;
+		if (fit(i, t_width, t_height, y))
+		{
+			unsigned top = y + t_height;
+			if (bestIndex == m_skyline.size() || top < bestTop || (top == bestTop && m_skyline[i].width < bestWidth))
+			{
+				bestIndex = i;
+				bestTop = top;
+				bestWidth = m_skyline[i].width;
+			}
+		}
+	}
+
+	if (bestIndex == m_skyline.size())
+	{
+		return false;
+	}
+
+	t_position = sf::Vector2u(m_skyline[bestIndex].x, bestTop - t_height);
+
+	// Raise the skyline under the new rectangle, then cut away what it covers of the following segments.
+	Segment raised{ t_position.x, bestTop, t_width };
+	m_skyline.insert(m_skyline.begin() + bestIndex, raised);
+
+	std::size_t i = bestIndex + 1;
+	while (i < m_skyline.size())
+	{
+		unsigned coveredEnd = raised.x + raised.width;
+		Segment& segment = m_skyline[i];
+		if (segment.x >= coveredEnd)
+		{
+			break;
+		}
+
+		unsigned overlap = coveredEnd - segment.x;
+		if (overlap < segment.width)
+		{
+			segment.x += overlap;
+			segment.width -= overlap;
+			break;
+		}
+		m_skyline.erase(m_skyline.begin() + i);
+	}
+
+	// Merge neighbours of equal height.
+	for (std::size_t j = 0; j + 1 < m_skyline.size();)
+	{
+		if (m_skyline[j].y == m_skyline[j + 1].y)
+		{
+			m_skyline[j].width += m_skyline[j + 1].width;
+			m_skyline.erase(m_skyline.begin() + j + 1);
+		}
+		else
+		{
+			++j;
+		}
+	}
+
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+bool SkylinePacker::fit(std::size_t t_index, unsigned t_width, unsigned t_height, unsigned& t_y) const
+{
+	if (m_skyline[t_index].x + t_width > m_width)
+	{
+		return false;
+	}
+
+	// The rectangle rests on the highest segment it spans.
+	unsigned y = 0;
+	unsigned remaining = t_width;
+	for (std::size_t i = t_index; remaining > 0; ++i)
+	{
+		y = std::max(y, m_skyline[i].y);
+		if (y + t_height > m_height)
+		{
+			return false;
+		}
+		remaining -= std::min(remaining, m_skyline[i].width);
+	}
+
+	t_y = y;
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+TextureAtlas::TextureAtlas(unsigned t_padding)
+	: m_padding(t_padding)
+{
+}
+
+////////////////////////////////////////////////////////////
+void TextureAtlas::add(const std::string& t_name, const sf::Image& t_image)
+{
+	m_entries.push_back(Entry{ t_name, t_image });
+}
+
+////////////////////////////////////////////////////////////
+bool TextureAtlas::build(unsigned t_maxSize)
+{
+	// Tall images first packs tighter with the skyline heuristic.
+	std::stable_sort(m_entries.begin(), m_entries.end(), [](const Entry& t_lhs, const Entry& t_rhs)
+	{
+		return t_lhs.image.getSize().y > t_rhs.image.getSize().y;
+	});
+
+	// Start with the smallest power of two square that could hold the total area, then grow alternately in width and height.
+	unsigned long long area = 0;
+	for (const Entry& entry : m_entries)
+	{
+		area += static_cast<unsigned long long>(entry.image.getSize().x + m_padding) * (entry.image.getSize().y + m_padding);
+	}
+	unsigned width = 1;
+	while (static_cast<unsigned long long>(width) * width < area)
+	{
+		width *= 2;
+	}
+	unsigned height = width;
+
+	std::vector<sf::Vector2u> positions;
+	while (!pack(width, height, positions))
+	{
+		if (width > height)
+		{
+			height *= 2;
+		}
+		else
+		{
+			width *= 2;
+		}
+		if (width > t_maxSize || height > t_maxSize)
+		{
+			return false;
+		}
+	}
+
+	m_image.create(width, height, sf::Color::Transparent);
+	m_rects.clear();
+	for (std::size_t i = 0; i < m_entries.size(); ++i)
+	{
+		const sf::Image& image = m_entries[i].image;
+		m_image.copy(image, positions[i].x, positions[i].y);
+		m_rects[m_entries[i].name] = sf::IntRect(positions[i].x, positions[i].y, image.getSize().x, image.getSize().y);
+	}
+	m_entries.clear();
+
+	return m_texture.loadFromImage(m_image);
+}
+
+////////////////////////////////////////////////////////////
+const sf::Texture& TextureAtlas::getTexture() const
+{
+	return m_texture;
+}
+
+////////////////////////////////////////////////////////////
+const sf::Image& TextureAtlas::getImage() const
+{
+	return m_image;
+}
+
+////////////////////////////////////////////////////////////
+sf::IntRect TextureAtlas::getRect(const std::string& t_name) const
+{
+	return m_rects.at(t_name);
+}
+
+////////////////////////////////////////////////////////////
+sf::IntRect TextureAtlas::getRect(const std::string& t_name, const sf::IntRect& t_subRect) const
+{
+	sf::IntRect rect = getRect(t_name);
+	return sf::IntRect(rect.left + t_subRect.left, rect.top + t_subRect.top, t_subRect.width, t_subRect.height);
+}
+
+////////////////////////////////////////////////////////////
+bool TextureAtlas::pack(unsigned t_width, unsigned t_height, std::vector<sf::Vector2u>& t_positions) const
+{
+	// Padding is added to the right and bottom of every image; the bin is enlarged so that the last row and column fit.
+	SkylinePacker packer(t_width + m_padding, t_height + m_padding);
+	t_positions.resize(m_entries.size());
+	for (std::size_t i = 0; i < m_entries.size(); ++i)
+	{
+		sf::Vector2u size = m_entries[i].image.getSize();
+		if (!packer.insert(size.x + m_padding, size.y + m_padding, t_positions[i]))
+		{
+			return false;
+		}
+	}
+	return true;
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Texture.hpp>
+
+#include <map>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// @brief Packs rectangles into a fixed size bin with the skyline bottom-left heuristic.
+///
+/// The skyline is the upper contour of everything placed so far. Each rectangle is
+///  put where its top edge ends up lowest, which leaves little wasted space for
+///  the mix of sprite sheets and small textures a game typically has.
+/// </summary>
+class SkylinePacker
+{
+public:
+	SkylinePacker(unsigned t_width, unsigned t_height);
+
+	/// <summary>
+	/// @brief Finds a place for a rectangle and marks it as used.
+	/// </summary>
+	/// <param name="t_width">Width of the rectangle</param>
+	/// <param name="t_height">Height of the rectangle</param>
+	/// <param name="t_position">Receives the top left corner of the placed rectangle</param>
+	/// <returns>false if the rectangle does not fit anymore.</returns>
+	bool insert(unsigned t_width, unsigned t_height, sf::Vector2u& t_position);
+
+private:
+	// A horizontal segment of the skyline.
+	struct Segment
+	{
+		unsigned x;
+		unsigned y;
+		unsigned width;
+	};
+
+	// Returns the y position a rectangle placed at the given segment would have, or false if it does not fit.
+	bool fit(std::size_t t_index, unsigned t_width, unsigned t_height, unsigned& t_y) const;
+
+	unsigned m_width;
+	unsigned m_height;
+	std::vector<Segment> m_skyline;
+};
+
+/// <summary>
+/// @brief Combines several images into one texture, with named sub-rectangles.
+///
+/// Everything that is drawn from the atlas shares a single texture, so consecutive
+///  draws need no texture switch and can be batched. Images are packed with a
+///  SkylinePacker into the smallest power of two size that fits them.
+/// Example usage:
+///		TextureAtlas atlas;
+///		atlas.add("SpriteSheet", spriteSheetImage);
+///		atlas.add("Smoke", smokeImage);
+///		atlas.build();
+///		sprite.setTexture(atlas.getTexture());
+///		sprite.setTextureRect(atlas.getRect("SpriteSheet", sf::IntRect(2, 43, 79, 43)));
+/// </summary>
+class TextureAtlas
+{
+public:
+	/// <summary>
+	/// @brief Creates an empty atlas.
+	/// </summary>
+	/// <param name="t_padding">Transparent pixels between images, so that filtering does not bleed into neighbours</param>
+	explicit TextureAtlas(unsigned t_padding = 2);
+
+	/// <summary>
+	/// @brief Adds an image to be packed by the next build().
+	/// The image is copied, so it can be released afterwards.
+	/// </summary>
+	void add(const std::string& t_name, const sf::Image& t_image);
+
+	/// <summary>
+	/// @brief Packs all added images and uploads the atlas texture.
+	/// The added images are released afterwards.
+	/// </summary>
+	/// <param name="t_maxSize">The maximum width and height of the atlas</param>
+	/// <returns>false if the images do not fit or the texture could not be created.</returns>
+	bool build(unsigned t_maxSize = sf::Texture::getMaximumSize());
+
+	const sf::Texture& getTexture() const;
+
+	/// <summary>
+	/// @brief Returns the pixels of the atlas texture, for drawing without a GPU.
+	/// </summary>
+	const sf::Image& getImage() const;
+
+	/// <summary>
+	/// @brief Returns the area of the named image within the atlas.
+	/// Throws std::out_of_range if there is no image with that name.
+	/// </summary>
+	sf::IntRect getRect(const std::string& t_name) const;
+
+	/// <summary>
+	/// @brief Converts a rectangle within the named image to atlas coordinates.
+	/// </summary>
+	sf::IntRect getRect(const std::string& t_name, const sf::IntRect& t_subRect) const;
+
+private:
+	struct Entry
+	{
+		std::string name;
+		sf::Image image;
+	};
+
+	// Tries to place all entries into a bin of the given size.
+	bool pack(unsigned t_width, unsigned t_height, std::vector<sf::Vector2u>& t_positions) const;
+
+	unsigned m_padding;
+	std::vector<Entry> m_entries;
+	std::map<std::string, sf::IntRect> m_rects;
+	// CPU copy of the texture.
+	sf::Image m_image;
+	sf::Texture m_texture;
+};
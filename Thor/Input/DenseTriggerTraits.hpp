@@ -0,0 +1,84 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2015 Jan Haller
+// 
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+// 
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+// 
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+/// @file
+/// @brief Traits template thor::DenseTriggerTraits
+
+#ifndef THOR_DENSETRIGGERTRAITS_HPP
+#define THOR_DENSETRIGGERTRAITS_HPP
+
+#include <SFML/Window/Event.hpp>
+
+#include <cstddef>
+
+
+namespace thor
+{
+
+/// @addtogroup Input
+/// @{
+
+/// @brief Traits to store the listeners of an event identifier type in a flat table
+/// @details By default, thor::EventSystem keeps its listeners in a tree sorted by identifier. For identifiers that convert
+///  to small, contiguous integers, a table indexed by the identifier is faster: triggering an event becomes an array access
+///  plus a linear scan over its listeners. Specialize this template to opt in, with the following static members:
+/// @code
+/// namespace thor
+/// {
+///     template <>
+///     struct DenseTriggerTraits<MyEventId>
+///     {
+///         static const bool isDense = true;
+///         static const std::size_t count = MyEventId::Count; // identifiers must be in [0, count[
+///     };
+/// }
+/// @endcode
+///  Identifiers outside of [0, count[ are still accepted, their listeners are stored as if the type were not dense.
+///  Listeners may connect and disconnect other listeners while they are called, in both layouts. In the table, a listener
+///  connected during a call receives events from the next one on.
+///  sf::Event::EventType is dense by default.
+template <typename EventId>
+struct DenseTriggerTraits
+{
+	/// @brief Whether the identifiers index a flat table
+	static const bool			isDense = false;
+
+	/// @brief Number of table entries; identifiers in [0, count[ use the table
+	static const std::size_t	count = 0;
+};
+
+/// @brief Flat table for the SFML event types
+template <>
+struct DenseTriggerTraits<sf::Event::EventType>
+{
+	static const bool			isDense = true;
+	static const std::size_t	count = sf::Event::Count;
+};
+
+/// @}
+
+} // namespace thor
+
+#endif // THOR_DENSETRIGGERTRAITS_HPP
@@ -29,10 +29,12 @@
 #include <Thor/Config.hpp>
 #include <Aurora/Tools/ForEach.hpp>
 #include <Thor/Input/Connection.hpp>
+#include <Thor/Input/DenseTriggerTraits.hpp>
 #include <Thor/Input/Detail/ConnectionImpl.hpp>
 
 #include <functional>
 #include <vector>
+#include <deque>
 #include <map>
 #include <algorithm>
 
@@ -151,7 +153,8 @@ namespace detail
 
 
 	// Associative container (map) for listener
-	template <typename Trigger, typename Parameter>
+	// Triggers that opt in through DenseTriggerTraits (e.g. sf::Event::EventType) use the flat table specialization below.
+	template <typename Trigger, typename Parameter, bool DenseTrigger = DenseTriggerTraits<Trigger>::isDense>
 	class ListenerMap
 	{
 		public:
@@ -213,10 +216,236 @@ namespace detail
 					itr->second.call(arg);
 			}
 
+			// Invokes the functions associated with event once for every argument in [begin, end).
+			template <typename ArgIterator>
+			void callEach(Trigger event, ArgIterator begin, ArgIterator end) const
+			{
+				std::pair<ConstIterator, ConstIterator> range = mListeners.equal_range(event);
+
+				for (ArgIterator arg = begin; arg != end; ++arg)
+				{
+					for (ConstIterator itr = range.first; itr != range.second; ++itr)
+						itr->second.call(*arg);
+				}
+			}
+
 		private:
 			Container mListeners;
 	};
 
+
+	// Flat table for listeners of dense triggers.
+	// The trigger is used as index into a table of contiguous listener vectors, so that calling the listeners of an event
+	// is an array access plus a linear scan. Removed listeners leave a tombstone whose slot is recycled by the next add()
+	// to the same trigger, thus the positions referred to by existing connections never move. Triggers outside of
+	// [0, DenseTriggerTraits<Trigger>::count[ are stored in a multimap instead, so the table never grows beyond that size.
+	// Like with the multimap, listeners may connect and disconnect listeners while they are called: the table is allocated
+	// completely by the first add(), and slots are kept in deques, so no listener moves while the table is in use. Listeners
+	// connected during a call receive events from the next one on; tombstones are only recycled when no call is running.
+	// Clearing listeners from within a listener is not supported, as it would destroy the running listener.
+	template <typename Trigger, typename Parameter>
+	class ListenerMap<Trigger, Parameter, true>
+	{
+		public:
+			// The type of the function together with the id
+			typedef Listener<Parameter>							ValueType;
+
+			// The event identifier associated with the listener
+			typedef Trigger										KeyType;
+
+			// The iterator type (used to disconnect listeners): position in the table
+			struct Iterator
+			{
+				std::size_t		bucket;
+				std::size_t		slot;
+			};
+
+		private:
+			// Container for triggers that don't fit into the table
+			typedef ListenerMap<Trigger, Parameter, false>		SparseMap;
+
+			struct Slot
+			{
+				explicit Slot(const ValueType& listener)
+				: listener(listener)
+				, active(true)
+				{
+				}
+
+				ValueType		listener;
+				bool			active;
+			};
+
+			struct Bucket
+			{
+				std::deque<Slot>			slots;
+				std::vector<std::size_t>	freeSlots;
+			};
+
+			// Counts the running calls, also when a listener throws
+			class CallGuard
+			{
+				public:
+					explicit CallGuard(std::size_t& depth)
+					: mDepth(depth)
+					{
+						++mDepth;
+					}
+
+					~CallGuard()
+					{
+						--mDepth;
+					}
+
+				private:
+					CallGuard(const CallGuard&);
+					CallGuard& operator= (const CallGuard&);
+
+				private:
+					std::size_t&	mDepth;
+			};
+
+		public:
+			ListenerMap()
+			: mBuckets()
+			, mSparseListeners()
+			, mCallDepth(0)
+			{
+			}
+
+			// Inserts a new listener to the collection and returns the respective Connection.
+			Connection add(const KeyType& trigger, const ValueType& listener)
+			{
+				Iterator added;
+				if (!toIndex(trigger, added.bucket))
+					return mSparseListeners.add(trigger, listener);
+
+				// Allocate the whole table at once, so that it is never resized while listeners are called
+				if (mBuckets.empty())
+					mBuckets.resize(DenseTriggerTraits<Trigger>::count);
+
+				// Reuse a tombstone if possible, otherwise append. A recycled slot could be visited by a running call.
+				Bucket& bucket = mBuckets[added.bucket];
+				if (bucket.freeSlots.empty() || mCallDepth > 0)
+				{
+					added.slot = bucket.slots.size();
+					bucket.slots.push_back(Slot(listener));
+				}
+				else
+				{
+					added.slot = bucket.freeSlots.back();
+					bucket.freeSlots.pop_back();
+					bucket.slots[added.slot] = Slot(listener);
+				}
+
+				// Let the Listener know about its container and position
+				Slot& slot = bucket.slots[added.slot];
+				slot.listener.setEnvironment(*this, added);
+
+				// Create connection from the added Listener
+				return slot.listener.shareConnection();
+			}
+
+			// Removes a listener through the given iterator, leaving a tombstone.
+			// Listeners in the sparse map are connected to that map, so they are never removed through this function.
+			void remove(Iterator iterator)
+			{
+				Bucket& bucket = mBuckets[iterator.bucket];
+				Slot& slot = bucket.slots[iterator.slot];
+
+				// Release function and connection tracker (invalidates all connections to the listener)
+				ValueType released(nullptr);
+				slot.listener.swap(released);
+				slot.active = false;
+
+				bucket.freeSlots.push_back(iterator.slot);
+			}
+
+			// Removes all listeners for a specific key
+			void clear(KeyType key)
+			{
+				std::size_t index;
+				if (!toIndex(key, index))
+					mSparseListeners.clear(key);
+				else if (index < mBuckets.size())
+					mBuckets[index] = Bucket();
+			}
+
+			// Removes all listeners from the container
+			void clearAll()
+			{
+				mBuckets.clear();
+				mSparseListeners.clearAll();
+			}
+
+			// Invokes all stored functions with arg as argument.
+			void call(Trigger event, Parameter arg) const
+			{
+				std::size_t index;
+				if (!toIndex(event, index))
+				{
+					mSparseListeners.call(event, arg);
+					return;
+				}
+
+				if (index >= mBuckets.size())
+					return;
+
+				CallGuard guard(mCallDepth);
+				callBucket(index, arg);
+			}
+
+			// Invokes the functions associated with event once for every argument in [begin, end).
+			template <typename ArgIterator>
+			void callEach(Trigger event, ArgIterator begin, ArgIterator end) const
+			{
+				std::size_t index;
+				if (!toIndex(event, index))
+				{
+					mSparseListeners.callEach(event, begin, end);
+					return;
+				}
+
+				if (index >= mBuckets.size())
+					return;
+
+				CallGuard guard(mCallDepth);
+				for (ArgIterator arg = begin; arg != end; ++arg)
+					callBucket(index, *arg);
+			}
+
+		private:
+			// Calls the listeners of a bucket that exist when the call starts. Listeners can add slots while being called,
+			// so the slots are looked up by index instead of iterating over the container.
+			void callBucket(std::size_t index, Parameter arg) const
+			{
+				const std::deque<Slot>& slots = mBuckets[index].slots;
+				const std::size_t count = slots.size();
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					if (slots[i].active)
+						slots[i].listener.call(arg);
+				}
+			}
+
+			// Stores the table index of trigger in index. Returns false if the trigger is outside of the table, e.g. a
+			// negative value like sf::Keyboard::Unknown, which must not be converted to a huge unsigned index.
+			static bool toIndex(Trigger trigger, std::size_t& index)
+			{
+				const long long value = static_cast<long long>(trigger);
+				if (value < 0 || value >= static_cast<long long>(DenseTriggerTraits<Trigger>::count))
+					return false;
+
+				index = static_cast<std::size_t>(value);
+				return true;
+			}
+
+		private:
+			std::vector<Bucket>		mBuckets;
+			SparseMap				mSparseListeners;
+			mutable std::size_t		mCallDepth;
+	};
+
 } // namespace detail
 } // namespace thor
 
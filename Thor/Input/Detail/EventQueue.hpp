@@ -0,0 +1,193 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2015 Jan Haller
+// 
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+// 
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+// 
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef THOR_EVENTQUEUE_HPP
+#define THOR_EVENTQUEUE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+
+namespace thor
+{
+namespace detail
+{
+
+	// Bounded multi-producer single-consumer ring buffer.
+	// Any thread may push(), only one thread at a time may pop(). Each cell carries a sequence number that tells
+	// producers and the consumer whether the cell is free or filled, so neither side ever takes a lock. Events must be
+	// default-constructible and copy-assignable.
+	template <typename Event>
+	class EventQueue
+	{
+		private:
+			struct Cell
+			{
+				std::atomic<std::size_t>	sequence;
+				Event						event;
+			};
+
+			// Keep producer and consumer positions on different cache lines
+			static const std::size_t CacheLineSize = 64;
+
+		public:
+			// Creates a queue without storage; call reserve() before use
+			EventQueue()
+			: mCells()
+			, mMask(0)
+			, mEnqueuePos(0)
+			, mDequeuePos(0)
+			{
+			}
+
+			// Allocates room for capacity events (rounded up to a power of two). Not thread-safe, call before
+			// any producer starts. Discards events that are still queued.
+			void reserve(std::size_t capacity)
+			{
+				std::size_t size = 2;
+				while (size < capacity)
+					size *= 2;
+
+				mCells.reset(new Cell[size]);
+				for (std::size_t i = 0; i < size; ++i)
+					mCells[i].sequence.store(i, std::memory_order_relaxed);
+
+				mMask = size - 1;
+				mEnqueuePos.store(0, std::memory_order_relaxed);
+				mDequeuePos = 0;
+			}
+
+			// Returns whether reserve() has been called
+			bool isReserved() const
+			{
+				return mCells != nullptr;
+			}
+
+			// Returns the maximal number of events that can be queued at once
+			std::size_t getCapacity() const
+			{
+				return isReserved() ? mMask + 1 : 0;
+			}
+
+			// Enqueues an event, may be called from any thread. Returns false if the queue is full or has no storage.
+			bool push(const Event& event)
+			{
+				if (!isReserved())
+					return false;
+
+				std::size_t pos = mEnqueuePos.load(std::memory_order_relaxed);
+				Cell* cell;
+
+				for (;;)
+				{
+					cell = &mCells[pos & mMask];
+					std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+					std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+
+					// Cell is free: try to claim it
+					if (diff == 0)
+					{
+						if (mEnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+							break;
+					}
+					// Cell still holds an event the consumer has not read: queue is full
+					else if (diff < 0)
+					{
+						return false;
+					}
+					// Another producer claimed the cell first
+					else
+					{
+						pos = mEnqueuePos.load(std::memory_order_relaxed);
+					}
+				}
+
+				cell->event = event;
+				cell->sequence.store(pos + 1, std::memory_order_release);
+				return true;
+			}
+
+			// Dequeues the oldest event into event. Only the consumer thread may call this.
+			// Returns false if no published event is available.
+			bool pop(Event& event)
+			{
+				if (!isReserved())
+					return false;
+
+				Cell* cell = &mCells[mDequeuePos & mMask];
+				std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+
+				if (static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(mDequeuePos + 1) < 0)
+					return false;
+
+				event = cell->event;
+				cell->sequence.store(mDequeuePos + mMask + 1, std::memory_order_release);
+				++mDequeuePos;
+				return true;
+			}
+
+		private:
+			std::unique_ptr<Cell[]>		mCells;
+			std::size_t					mMask;
+			char						mPadding0[CacheLineSize];
+			std::atomic<std::size_t>	mEnqueuePos;
+			char						mPadding1[CacheLineSize];
+			std::size_t					mDequeuePos;
+	};
+
+	// Stable merge sort that alternates between events and buffer. Unlike std::stable_sort, it doesn't allocate as long as
+	// buffer has the capacity for all events.
+	template <typename Event, typename Less>
+	void stableSortWithBuffer(std::vector<Event>& events, std::vector<Event>& buffer, Less less)
+	{
+		const std::size_t size = events.size();
+		buffer.resize(size);
+
+		Event* from = events.data();
+		Event* to = buffer.data();
+		for (std::size_t width = 1; width < size; width *= 2)
+		{
+			for (std::size_t begin = 0; begin < size; begin += 2 * width)
+			{
+				const std::size_t middle = std::min(begin + width, size);
+				const std::size_t end = std::min(begin + 2 * width, size);
+				std::merge(from + begin, from + middle, from + middle, from + end, to + begin, less);
+			}
+
+			std::swap(from, to);
+		}
+
+		if (from != events.data())
+			std::copy(from, from + size, events.data());
+	}
+
+} // namespace detail
+} // namespace thor
+
+#endif // THOR_EVENTQUEUE_HPP
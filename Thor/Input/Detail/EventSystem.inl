@@ -29,9 +29,24 @@ namespace thor
 template <typename Event, typename EventId>
 EventSystem<Event, EventId>::EventSystem()
 : mListeners()
+, mQueue()
+, mDispatchedEvents()
+, mSortBuffer()
 {
 }
 
+template <typename Event, typename EventId>
+EventSystem<Event, EventId>::EventSystem(std::size_t queueCapacity)
+: mListeners()
+, mQueue()
+, mDispatchedEvents()
+, mSortBuffer()
+{
+	mQueue.reserve(queueCapacity);
+	mDispatchedEvents.reserve(mQueue.getCapacity());
+	mSortBuffer.reserve(mQueue.getCapacity());
+}
+
 template <typename Event, typename EventId>
 void EventSystem<Event, EventId>::triggerEvent(const Event& event)
 {
@@ -41,6 +56,46 @@ void EventSystem<Event, EventId>::triggerEvent(const Event& event)
 	mListeners.call(getEventId(event), event);
 }
 
+template <typename Event, typename EventId>
+bool EventSystem<Event, EventId>::queueEvent(const Event& event)
+{
+	return mQueue.push(event);
+}
+
+template <typename Event, typename EventId>
+void EventSystem<Event, EventId>::dispatchQueuedEvents()
+{
+	// Import symbol getEventId to qualify for ADL.
+	using namespace detail;
+
+	// Take at most one queue's worth of events, so that busy producers cannot keep this call from returning
+	mDispatchedEvents.clear();
+	Event event;
+	for (std::size_t i = 0, capacity = mQueue.getCapacity(); i < capacity && mQueue.pop(event); ++i)
+		mDispatchedEvents.push_back(event);
+
+	// Group by identifier, keeping the original order within each group. Sorting into the preallocated buffer keeps
+	// the drain free of allocations.
+	stableSortWithBuffer(mDispatchedEvents, mSortBuffer, [] (const Event& lhs, const Event& rhs)
+	{
+		return getEventId(lhs) < getEventId(rhs);
+	});
+
+	// Look up the listeners once per group
+	auto first = mDispatchedEvents.begin();
+	while (first != mDispatchedEvents.end())
+	{
+		const EventId id = getEventId(*first);
+		auto last = std::find_if(first, mDispatchedEvents.end(), [&id] (const Event& e)
+		{
+			return id < getEventId(e);
+		});
+
+		mListeners.callEach(id, first, last);
+		first = last;
+	}
+}
+
 template <typename Event, typename EventId>
 Connection EventSystem<Event, EventId>::connect(const EventId& trigger, std::function<void(const Event&)> unaryListener)
 {
@@ -30,9 +30,12 @@
 #define THOR_EVENTSYSTEM_HPP
 
 #include <Thor/Input/Detail/EventListener.hpp>
+#include <Thor/Input/Detail/EventQueue.hpp>
 
 #include <Aurora/Tools/NonCopyable.hpp>
 
+#include <vector>
+
 
 namespace thor
 {
@@ -47,6 +50,9 @@ namespace thor
 ///  events where @a EventId and @a Event are distinct types, you have to provide a global function
 ///  <b>EventId getEventId(const Event&)</b> in the namespace of the @a Event type definition. Besides, the
 ///  event system requires less-than operator < for @a EventId (enums can use the implicit conversion to int).
+///  @n@n Besides the synchronous triggerEvent(), events can be queued from any thread with queueEvent() and dispatched
+///  later on the thread owning the event system with dispatchQueuedEvents(). Queued mode requires @a Event to be
+///  default-constructible and copy-assignable.
 template <typename Event, typename EventId = Event>
 class EventSystem : private aurora::NonCopyable
 {
@@ -57,10 +63,29 @@ class EventSystem : private aurora::NonCopyable
 		/// @details Sets up an EventSystem where @a Event and @a EventId are the same types.
 									EventSystem();
 
+		/// @brief Constructor: Sets up an EventSystem that can queue events.
+		/// @param queueCapacity Maximal number of events that can wait for dispatchQueuedEvents(). It is rounded up to a
+		///  power of two. The storage is allocated once; queueing never allocates.
+		explicit					EventSystem(std::size_t queueCapacity);
+
 		/// @brief Fires an event.
 		/// @details Calls all listener functions that are currently associated with @a event.
 		void						triggerEvent(const Event& event);
 
+		/// @brief Queues an event for later dispatch.
+		/// @details This function is lock-free and may be called concurrently from any number of threads. The listeners
+		///  are not invoked until dispatchQueuedEvents() is called. The event system must have been constructed with a
+		///  queue capacity; otherwise the event is dropped.
+		/// @return true if the event was queued, false if the queue is full (or has no capacity) and the event was dropped.
+		bool						queueEvent(const Event& event);
+
+		/// @brief Calls the listeners of all events queued so far.
+		/// @details Only one thread may dispatch at a time, normally the one that connects the listeners. Events with the
+		///  same identifier are dispatched in the order they were queued, but events are grouped by identifier, so that the
+		///  listeners of each identifier are looked up once per call instead of once per event. Events queued while
+		///  listeners run are dispatched by the next call.
+		void						dispatchQueuedEvents();
+
 		/// @brief Connects an event to the specified unary listener.
 		/// @details Duplicates are allowed (thus, the listener is invoked multiple times). Use this function if your callback
 		///  should receive the event that triggered it as a parameter.
@@ -103,6 +128,9 @@ class EventSystem : private aurora::NonCopyable
 	// Private variables
 	private:
 		EventListenerMap			mListeners;
+		detail::EventQueue<Event>	mQueue;
+		std::vector<Event>			mDispatchedEvents;
+		std::vector<Event>			mSortBuffer;
 };
 
 /// @}
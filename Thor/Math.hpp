@@ -31,6 +31,8 @@
 
 #include <Thor/Math/Distribution.hpp>
 #include <Thor/Math/Distributions.hpp>
+#include <Thor/Math/MemoryArena.hpp>
+#include <Thor/Math/Predicates.hpp>
 #include <Thor/Math/Random.hpp>
 #include <Thor/Math/Trigonometry.hpp>
 #include <Thor/Math/Triangulation.hpp>
@@ -0,0 +1,159 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2015 Jan Haller
+// 
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+// 
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+// 
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+namespace thor
+{
+
+inline MemoryArena::MemoryArena(std::size_t chunkSize)
+: mChunks()
+, mOffset(0)
+, mBytesUsed(0)
+, mAllocationCount(0)
+, mChunkAllocationCount(0)
+{
+	addChunk(chunkSize);
+}
+
+inline void* MemoryArena::allocate(std::size_t size, std::size_t alignment)
+{
+	assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+
+	Chunk* chunk = &mChunks.back();
+	std::uintptr_t base = reinterpret_cast<std::uintptr_t>(chunk->memory.get());
+	std::size_t offset = static_cast<std::size_t>(((base + mOffset + alignment - 1) & ~std::uintptr_t(alignment - 1)) - base);
+
+	if (offset + size > chunk->size)
+	{
+		// The rest of this chunk stays unused until the next reset() merges the chunks
+		addChunk(std::max(2 * chunk->size, size + alignment));
+		chunk = &mChunks.back();
+		base = reinterpret_cast<std::uintptr_t>(chunk->memory.get());
+		offset = static_cast<std::size_t>(((base + alignment - 1) & ~std::uintptr_t(alignment - 1)) - base);
+	}
+
+	mOffset = offset + size;
+	mBytesUsed += size;
+	++mAllocationCount;
+	return chunk->memory.get() + offset;
+}
+
+inline void MemoryArena::reset()
+{
+	if (mChunks.size() > 1)
+	{
+		std::size_t totalSize = 0;
+		for (std::size_t i = 0; i < mChunks.size(); ++i)
+			totalSize += mChunks[i].size;
+
+		mChunks.clear();
+		addChunk(totalSize);
+	}
+
+	mOffset = 0;
+	mBytesUsed = 0;
+	mAllocationCount = 0;
+}
+
+inline std::size_t MemoryArena::getBytesUsed() const
+{
+	return mBytesUsed;
+}
+
+inline std::size_t MemoryArena::getAllocationCount() const
+{
+	return mAllocationCount;
+}
+
+inline std::size_t MemoryArena::getChunkAllocationCount() const
+{
+	return mChunkAllocationCount;
+}
+
+inline void MemoryArena::addChunk(std::size_t size)
+{
+	Chunk chunk = { std::unique_ptr<char[]>(new char[size]), size };
+	mChunks.push_back(std::move(chunk));
+	mOffset = 0;
+	++mChunkAllocationCount;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------
+
+
+namespace detail
+{
+
+	// Standard allocator that takes memory from an arena, or from the heap if there is none. Memory from the arena is only
+	// released when the arena is reset.
+	template <typename T>
+	struct ArenaAllocator
+	{
+		typedef T value_type;
+
+		ArenaAllocator(MemoryArena* arena = nullptr)
+		: arena(arena)
+		{
+		}
+
+		template <typename U>
+		ArenaAllocator(const ArenaAllocator<U>& origin)
+		: arena(origin.arena)
+		{
+		}
+
+		T* allocate(std::size_t count)
+		{
+			if (arena)
+				return static_cast<T*>(arena->allocate(count * sizeof(T), alignof(T)));
+			else
+				return static_cast<T*>(::operator new(count * sizeof(T)));
+		}
+
+		void deallocate(T* pointer, std::size_t)
+		{
+			if (!arena)
+				::operator delete(pointer);
+		}
+
+		MemoryArena* arena;
+	};
+
+	template <typename T, typename U>
+	bool operator== (const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs)
+	{
+		return lhs.arena == rhs.arena;
+	}
+
+	template <typename T, typename U>
+	bool operator!= (const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs)
+	{
+		return lhs.arena != rhs.arena;
+	}
+
+	template <typename T>
+	using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+} // namespace detail
+} // namespace thor
@@ -0,0 +1,291 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2015 Jan Haller
+// 
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+// 
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+// 
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+namespace thor
+{
+namespace detail
+{
+
+#ifdef THOR_PREDICATE_STATISTICS
+	// Number of evaluations on the calling thread, and of those that needed exact arithmetic
+	struct PredicateStatistics
+	{
+		std::uint64_t	orientationCalls;
+		std::uint64_t	orientationExact;
+		std::uint64_t	inCircleCalls;
+		std::uint64_t	inCircleExact;
+	};
+
+	inline PredicateStatistics& getPredicateStatistics()
+	{
+		static thread_local PredicateStatistics statistics = {};
+		return statistics;
+	}
+
+	#define THOR_COUNT_PREDICATE(counter) ++thor::detail::getPredicateStatistics().counter
+#else
+	#define THOR_COUNT_PREDICATE(counter) ((void) 0)
+#endif
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+
+
+	// Expansion arithmetic, after J. R. Shewchuk: "Adaptive Precision Floating-Point Arithmetic and Fast Robust Geometric
+	// Predicates" (1997). An expansion represents a number exactly as the sum of its components, which are doubles with
+	// non-overlapping bits in order of increasing magnitude. The last component has the sign of the whole sum, and zero
+	// components are dropped (zero itself is a single zero component).
+
+	// Relative rounding error of double: 2^-53
+	const double PredicateEpsilon = 1.1102230246251565e-16;
+
+	template <int Capacity>
+	struct Expansion
+	{
+		double	components[Capacity];
+		int		length;
+	};
+
+	// x + y == a + b exactly
+	inline void twoSum(double a, double b, double& x, double& y)
+	{
+		x = a + b;
+		double bVirtual = x - a;
+		double aVirtual = x - bVirtual;
+		y = (a - aVirtual) + (b - bVirtual);
+	}
+
+	// x + y == a + b exactly, if |a| >= |b|
+	inline void fastTwoSum(double a, double b, double& x, double& y)
+	{
+		x = a + b;
+		y = b - (x - a);
+	}
+
+	// x + y == a * b exactly
+	inline void twoProduct(double a, double b, double& x, double& y)
+	{
+		x = a * b;
+		y = std::fma(a, b, -x);
+	}
+
+	// Writes e + f to h, which must have room for eLength + fLength components; returns the length of h
+	inline int sumExpansions(int eLength, const double* e, int fLength, const double* f, double* h)
+	{
+		// Add the components of both expansions in order of increasing magnitude
+		int i = 0;
+		int j = 0;
+		auto nextComponent = [&] () -> double
+		{
+			if (j == fLength || (i < eLength && std::abs(e[i]) < std::abs(f[j])))
+				return e[i++];
+			else
+				return f[j++];
+		};
+
+		int length = 0;
+		double sum = nextComponent();
+		for (int k = 1; k < eLength + fLength; ++k)
+		{
+			double error;
+			twoSum(sum, nextComponent(), sum, error);
+			if (error != 0.0)
+				h[length++] = error;
+		}
+
+		if (sum != 0.0 || length == 0)
+			h[length++] = sum;
+		return length;
+	}
+
+	// Writes e * b to h, which must have room for 2 * eLength components; returns the length of h
+	inline int scaleExpansion(int eLength, const double* e, double b, double* h)
+	{
+		int length = 0;
+		double sum;
+		double error;
+		twoProduct(e[0], b, sum, error);
+		if (error != 0.0)
+			h[length++] = error;
+
+		for (int i = 1; i < eLength; ++i)
+		{
+			double product;
+			double productError;
+			twoProduct(e[i], b, product, productError);
+
+			double partial;
+			twoSum(sum, productError, partial, error);
+			if (error != 0.0)
+				h[length++] = error;
+
+			fastTwoSum(product, partial, sum, error);
+			if (error != 0.0)
+				h[length++] = error;
+		}
+
+		if (sum != 0.0 || length == 0)
+			h[length++] = sum;
+		return length;
+	}
+
+	inline Expansion<2> difference(double a, double b)
+	{
+		Expansion<2> result;
+		double x, y;
+		twoSum(a, -b, x, y);
+
+		result.length = 0;
+		if (y != 0.0)
+			result.components[result.length++] = y;
+		result.components[result.length++] = x;
+		return result;
+	}
+
+	template <int N, int M>
+	Expansion<N + M> sum(const Expansion<N>& e, const Expansion<M>& f)
+	{
+		Expansion<N + M> result;
+		result.length = sumExpansions(e.length, e.components, f.length, f.components, result.components);
+		return result;
+	}
+
+	template <int N>
+	Expansion<N> negate(Expansion<N> e)
+	{
+		for (int i = 0; i < e.length; ++i)
+			e.components[i] = -e.components[i];
+		return e;
+	}
+
+	template <int N, int M>
+	Expansion<2 * N * M> product(const Expansion<N>& e, const Expansion<M>& f)
+	{
+		// Sum of e scaled by each component of f, alternating between two buffers
+		Expansion<2 * N * M> results[2];
+		double scaled[2 * N];
+
+		int current = 0;
+		results[0].length = scaleExpansion(e.length, e.components, f.components[0], results[0].components);
+		for (int j = 1; j < f.length; ++j)
+		{
+			int scaledLength = scaleExpansion(e.length, e.components, f.components[j], scaled);
+			results[1 - current].length = sumExpansions(results[current].length, results[current].components,
+				scaledLength, scaled, results[1 - current].components);
+			current = 1 - current;
+		}
+
+		return results[current];
+	}
+
+	template <int N>
+	double estimate(const Expansion<N>& e)
+	{
+		return e.components[e.length - 1];
+	}
+
+	inline double orientationExact(sf::Vector2f a, sf::Vector2f b, sf::Vector2f c)
+	{
+		Expansion<2> acx = difference(a.x, c.x);
+		Expansion<2> acy = difference(a.y, c.y);
+		Expansion<2> bcx = difference(b.x, c.x);
+		Expansion<2> bcy = difference(b.y, c.y);
+
+		return estimate(sum(product(acx, bcy), negate(product(acy, bcx))));
+	}
+
+	inline double inCircleExact(sf::Vector2f a, sf::Vector2f b, sf::Vector2f c, sf::Vector2f d)
+	{
+		Expansion<2> adx = difference(a.x, d.x);
+		Expansion<2> ady = difference(a.y, d.y);
+		Expansion<2> bdx = difference(b.x, d.x);
+		Expansion<2> bdy = difference(b.y, d.y);
+		Expansion<2> cdx = difference(c.x, d.x);
+		Expansion<2> cdy = difference(c.y, d.y);
+
+		Expansion<16> aLift = sum(product(adx, adx), product(ady, ady));
+		Expansion<16> bLift = sum(product(bdx, bdx), product(bdy, bdy));
+		Expansion<16> cLift = sum(product(cdx, cdx), product(cdy, cdy));
+
+		Expansion<16> bc = sum(product(bdx, cdy), negate(product(cdx, bdy)));
+		Expansion<16> ca = sum(product(cdx, ady), negate(product(adx, cdy)));
+		Expansion<16> ab = sum(product(adx, bdy), negate(product(bdx, ady)));
+
+		return estimate(sum(sum(product(aLift, bc), product(bLift, ca)), product(cLift, ab)));
+	}
+
+} // namespace detail
+
+// ---------------------------------------------------------------------------------------------------------------------------
+
+
+inline double orientation(sf::Vector2f a, sf::Vector2f b, sf::Vector2f c)
+{
+	THOR_COUNT_PREDICATE(orientationCalls);
+
+	double left = (double(a.x) - c.x) * (double(b.y) - c.y);
+	double right = (double(a.y) - c.y) * (double(b.x) - c.x);
+	double determinant = left - right;
+
+	// Error bound of the determinant computed in double precision (Shewchuk's ccwerrboundA). A single comparison, because
+	// branches on the signs of the products are unpredictable. If both products are zero, so is the bound.
+	double bound = (3.0 + 16.0 * detail::PredicateEpsilon) * detail::PredicateEpsilon * (std::abs(left) + std::abs(right));
+	if (std::abs(determinant) >= bound)
+		return determinant;
+
+	THOR_COUNT_PREDICATE(orientationExact);
+	return detail::orientationExact(a, b, c);
+}
+
+inline double inCircle(sf::Vector2f a, sf::Vector2f b, sf::Vector2f c, sf::Vector2f d)
+{
+	THOR_COUNT_PREDICATE(inCircleCalls);
+
+	double adx = double(a.x) - d.x, ady = double(a.y) - d.y;
+	double bdx = double(b.x) - d.x, bdy = double(b.y) - d.y;
+	double cdx = double(c.x) - d.x, cdy = double(c.y) - d.y;
+
+	double bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+	double cdxady = cdx * ady, adxcdy = adx * cdy;
+	double adxbdy = adx * bdy, bdxady = bdx * ady;
+
+	double aLift = adx * adx + ady * ady;
+	double bLift = bdx * bdx + bdy * bdy;
+	double cLift = cdx * cdx + cdy * cdy;
+
+	double determinant = aLift * (bdxcdy - cdxbdy) + bLift * (cdxady - adxcdy) + cLift * (adxbdy - bdxady);
+
+	// Error bound of the determinant computed in double precision (Shewchuk's iccerrboundA)
+	double permanent = (std::abs(bdxcdy) + std::abs(cdxbdy)) * aLift
+	                 + (std::abs(cdxady) + std::abs(adxcdy)) * bLift
+	                 + (std::abs(adxbdy) + std::abs(bdxady)) * cLift;
+	double bound = (10.0 + 96.0 * detail::PredicateEpsilon) * detail::PredicateEpsilon * permanent;
+	if (std::abs(determinant) >= bound)
+		return determinant;
+
+	THOR_COUNT_PREDICATE(inCircleExact);
+	return detail::inCircleExact(a, b, c, d);
+}
+
+} // namespace thor
@@ -28,176 +28,1310 @@ namespace thor
 namespace detail
 {
 
-	// Forward declarations
-	class AdvancedTriangle;
-	class AdvancedVertex;
-	class AdvancedEdge;
-
-	struct OptTriangleIterator;
-	struct OptTriangleItrArray;
-
-	// Functor to sort advanced vertices by their positions, needed to store them inside std::set.
-	struct THOR_API CompareVertexPtrs
+	// Metafunction to get a CV-qualified iterator value type (std::iterator_traits<T>::value_type is not const)
+	template <typename T>
+	struct DereferencedIterator
 	{
-		bool operator() (const AdvancedVertex* lhs, const AdvancedVertex* rhs) const;
+		typedef typename std::remove_pointer<
+			typename std::iterator_traits<T>::pointer
+		>::type value_type;
 	};
 
-	// Functor to sort constrained edges by their positions, needed to store them inside std::set.
-	struct THOR_API CompareEdges
+	// Returns the position of a user vertex.
+	template <typename V>
+	sf::Vector2f getVertexPosition(const V& vertex)
 	{
-		bool operator() (const AdvancedEdge& lhs, const AdvancedEdge& rhs) const;
-	};
-
-	// Containers and iterators which don't depend on type directly
-	typedef std::set<AdvancedVertex*, CompareVertexPtrs>	VertexPtrSet;
-	typedef VertexPtrSet::iterator							VertexPtrIterator;
+		return TriangulationTraits<V>::getPosition(vertex);
+	}
 
 	// ---------------------------------------------------------------------------------------------------------------------------
 
 
-	// Class to represent a vertex for algorithm internals
-	class THOR_API AdvancedVertex
+	// Constrained Delaunay triangulation on flat arrays.
+	// Triangles are stored as three vertex indices each, counter-clockwise in a y-up coordinate system. Half-edge 3*t+i
+	// runs from corner i to corner (i+1)%3 of triangle t, and mHalfEdges stores the half-edge opposite to it in the adjacent
+	// triangle. Vertices are inserted along a Hilbert curve, and every vertex is located by walking from the triangle that
+	// was created last, which is therefore usually close. The Delaunay condition is restored by edge flips (Lawson).
+	// Constrained edges are inserted afterwards by flipping away the edges they cross (Sloan).
+	class DelaunayMesh
 	{
-		// Note: Public interface contains OptTriangleIterator instead of TriangleIterator, although iterators are always valid.
-		// The reason is to avoid dependency on the STL container (TriangleIterator requires full typedef)
 		public:
-			template <typename V>
-										AdvancedVertex(V& userVertex, OptTriangleIterator surroundingTriangle);
-										AdvancedVertex(float x, float y);
+			// Index of a missing half-edge or vertex
+			enum : std::uint32_t { None = 0xFFFFFFFFu };
+
+			// Part of the convex hull that is returned
+			enum Region
+			{
+				ConvexHull,			// All triangles
+				InsidePolygon,		// Triangles enclosed by the constrained edges
+				RightOfEdges,		// Triangles that cannot be reached from the left side of a constrained edge
+			};
+
+		public:
+			// All memory is taken from arena, or from the heap if it is null.
+			explicit DelaunayMesh(MemoryArena* arena = nullptr)
+			: mArena(arena)
+			, mPoints(arena)
+			, mCorners(arena)
+			, mHalfEdges(arena)
+			, mConstrained(arena)
+			, mVertexEdges(arena)
+			, mVertexMap(arena)
+			, mResult(arena)
+			, mResultTriangles(arena)
+			, mFlipStack(arena)
+			, mCrossedEdges(arena)
+			, mNewEdges(arena)
+			, mPendingEdges(arena)
+			{
+			}
 
-			sf::Vector2f				getPosition() const;
-			void						setSurroundingTriangle(OptTriangleIterator target);
-			OptTriangleIterator			getSurroundingTriangle() const;
+			// Triangulates the points. constrainedEdges contains pairs of indices into points.
+			template <typename PointVector, typename EdgeVector>
+			void triangulate(const PointVector& points, const EdgeVector& constrainedEdges, Region region)
+			{
+				mPoints.assign(points.begin(), points.end());
+				mCorners.clear();
+				mHalfEdges.clear();
+				mConstrained.clear();
+				mResult.clear();
+				mResultTriangles.clear();
+
+				const std::uint32_t pointCount = static_cast<std::uint32_t>(points.size());
+				if (pointCount < 3)
+					return;
+
+				mCorners.reserve(6 * pointCount + 3);
+				mHalfEdges.reserve(6 * pointCount + 3);
+				mConstrained.reserve(6 * pointCount + 3);
+				mVertexEdges.assign(pointCount + 3, None);
+				mVertexMap.resize(pointCount);
+				for (std::uint32_t i = 0; i < pointCount; ++i)
+					mVertexMap[i] = i;
+
+				// Start with a triangle that encloses all points by far; its corners are removed at the end
+				createBoundaryTriangle();
+
+				ArenaVector<std::uint32_t> order(mArena);
+				sortAlongHilbertCurve(order);
+				AURORA_FOREACH(std::uint32_t vertex, order)
+					insertVertex(vertex);
+
+				for (std::size_t i = 0; i + 1 < constrainedEdges.size(); i += 2)
+					insertConstrainedEdge(mVertexMap[constrainedEdges[i]], mVertexMap[constrainedEdges[i + 1]]);
+
+				collectTriangles(pointCount, constrainedEdges, region);
+			}
 
-			template <typename V>
-			V&							getUserVertex() const;
+			// Returns the triangles as three indices into the points each, in clockwise order.
+			const ArenaVector<std::uint32_t>& getTriangles() const
+			{
+				return mResult;
+			}
+
+			// Fills neighbors with three entries per triangle of getTriangles(): the index of the triangle on the other side of
+			// the edge from corner i to corner (i+1)%3, or None.
+			void getNeighbors(std::vector<std::uint32_t>& neighbors) const
+			{
+				ArenaVector<std::uint32_t> resultIndices(mCorners.size() / 3, None, mArena);
+				for (std::uint32_t i = 0; i < mResultTriangles.size(); ++i)
+					resultIndices[mResultTriangles[i]] = i;
+
+				// The corners were reversed, so edge i of a result triangle is half-edge 2-i of the mesh triangle
+				neighbors.resize(3 * mResultTriangles.size());
+				for (std::uint32_t i = 0; i < mResultTriangles.size(); ++i)
+				{
+					for (std::uint32_t k = 0; k < 3; ++k)
+					{
+						std::uint32_t opposite = mHalfEdges[3 * mResultTriangles[i] + 2 - k];
+						neighbors[3 * i + k] = (opposite == None) ? None : resultIndices[opposite / 3];
+					}
+				}
+			}
 
 		private:
-			void*									mUserVertex;
-			sf::Vector2f							mPosition;
-			aurora::CopiedPtr<OptTriangleIterator>	mSurroundingTriangle;
-#ifndef NDEBUG
-			const std::type_info*					mUserType;
-#endif
-	};
+			static std::uint32_t next(std::uint32_t halfEdge)
+			{
+				return halfEdge % 3 == 2 ? halfEdge - 2 : halfEdge + 1;
+			}
 
-	// Meta-information edge, for algorithm internals
-	class THOR_API AdvancedEdge : public Edge<AdvancedVertex>
-	{
-		public:
-										AdvancedEdge(AdvancedVertex& startPoint, AdvancedVertex& endPoint);
+			static std::uint32_t prev(std::uint32_t halfEdge)
+			{
+				return halfEdge % 3 == 0 ? halfEdge + 2 : halfEdge - 1;
+			}
+
+			// Positive if c is left of the line from a to b, negative if right, zero if collinear.
+			static double orientation(sf::Vector2f a, sf::Vector2f b, sf::Vector2f c)
+			{
+				return thor::orientation(a, b, c);
+			}
+
+			// Positive if d is inside the circumcircle of the counter-clockwise triangle abc.
+			static double inCircle(sf::Vector2f a, sf::Vector2f b, sf::Vector2f c, sf::Vector2f d)
+			{
+				return thor::inCircle(a, b, c, d);
+			}
+
+			// Position on a Hilbert curve of order 16 through the grid cell (x, y).
+			static std::uint32_t hilbertIndex(std::uint32_t x, std::uint32_t y)
+			{
+				const std::uint32_t n = 1u << 16;
+
+				std::uint32_t index = 0;
+				for (std::uint32_t s = n / 2; s > 0; s /= 2)
+				{
+					std::uint32_t rx = (x & s) > 0;
+					std::uint32_t ry = (y & s) > 0;
+					index += s * s * ((3 * rx) ^ ry);
+
+					if (ry == 0)
+					{
+						if (rx == 1)
+						{
+							x = n - 1 - x;
+							y = n - 1 - y;
+						}
+						std::swap(x, y);
+					}
+				}
+				return index;
+			}
+
+			std::uint32_t corner(std::uint32_t halfEdge) const
+			{
+				return mCorners[halfEdge];
+			}
+
+			sf::Vector2f position(std::uint32_t vertex) const
+			{
+				return mPoints[vertex];
+			}
+
+			std::uint32_t addTriangle()
+			{
+				std::uint32_t triangle = static_cast<std::uint32_t>(mCorners.size() / 3);
+				mCorners.resize(mCorners.size() + 3);
+				mHalfEdges.resize(mHalfEdges.size() + 3, None);
+				mConstrained.resize(mConstrained.size() + 3, 0);
+				return triangle;
+			}
+
+			// Sets the corners of a triangle. Every vertex of a replaced triangle must be a corner of one of the new ones,
+			// so that each vertex keeps referring to a valid outgoing half-edge.
+			void setCorners(std::uint32_t triangle, std::uint32_t v0, std::uint32_t v1, std::uint32_t v2)
+			{
+				mCorners[3 * triangle + 0] = v0;
+				mCorners[3 * triangle + 1] = v1;
+				mCorners[3 * triangle + 2] = v2;
+
+				mVertexEdges[v0] = 3 * triangle + 0;
+				mVertexEdges[v1] = 3 * triangle + 1;
+				mVertexEdges[v2] = 3 * triangle + 2;
+			}
+
+			// Makes two half-edges opposite to each other, and sets the constraint flag of both.
+			void link(std::uint32_t halfEdge, std::uint32_t opposite, std::uint8_t constrained = 0)
+			{
+				mHalfEdges[halfEdge] = opposite;
+				mConstrained[halfEdge] = constrained;
+
+				if (opposite != None)
+				{
+					mHalfEdges[opposite] = halfEdge;
+					mConstrained[opposite] = constrained;
+				}
+			}
+
+			void createBoundaryTriangle()
+			{
+				const std::uint32_t pointCount = static_cast<std::uint32_t>(mPoints.size());
+
+				sf::Vector2f min = mPoints[0];
+				sf::Vector2f max = mPoints[0];
+				AURORA_FOREACH(sf::Vector2f point, mPoints)
+				{
+					min.x = std::min(min.x, point.x);
+					min.y = std::min(min.y, point.y);
+					max.x = std::max(max.x, point.x);
+					max.y = std::max(max.y, point.y);
+				}
+
+				// The farther away the corners, the less they distort the convex hull
+				float size = 1000.f * std::max(std::max(max.x - min.x, max.y - min.y), 1.f);
+				sf::Vector2f center = (min + max) / 2.f;
+
+				mPoints.push_back(sf::Vector2f(center.x - 2.f * size, center.y - size));
+				mPoints.push_back(sf::Vector2f(center.x + 2.f * size, center.y - size));
+				mPoints.push_back(sf::Vector2f(center.x, center.y + 2.f * size));
+
+				std::uint32_t triangle = addTriangle();
+				setCorners(triangle, pointCount, pointCount + 1, pointCount + 2);
+				mLastTriangle = triangle;
+			}
+
+			// Fills order with the indices of the user points, sorted along a Hilbert curve.
+			void sortAlongHilbertCurve(ArenaVector<std::uint32_t>& order) const
+			{
+				const std::size_t pointCount = mVertexMap.size();
+
+				sf::Vector2f min = mPoints[0];
+				sf::Vector2f max = mPoints[0];
+				for (std::size_t i = 0; i < pointCount; ++i)
+				{
+					min.x = std::min(min.x, mPoints[i].x);
+					min.y = std::min(min.y, mPoints[i].y);
+					max.x = std::max(max.x, mPoints[i].x);
+					max.y = std::max(max.y, mPoints[i].y);
+				}
+
+				float extent = std::max(max.x - min.x, max.y - min.y);
+				float scale = extent > 0.f ? 65535.f / extent : 0.f;
+
+				ArenaVector<std::pair<std::uint32_t, std::uint32_t>> keys(pointCount, std::pair<std::uint32_t, std::uint32_t>(), mArena);
+				for (std::size_t i = 0; i < pointCount; ++i)
+				{
+					std::uint32_t x = static_cast<std::uint32_t>((mPoints[i].x - min.x) * scale);
+					std::uint32_t y = static_cast<std::uint32_t>((mPoints[i].y - min.y) * scale);
+					keys[i] = std::make_pair(hilbertIndex(x, y), static_cast<std::uint32_t>(i));
+				}
+				std::sort(keys.begin(), keys.end());
+
+				order.resize(pointCount);
+				for (std::size_t i = 0; i < pointCount; ++i)
+					order[i] = keys[i].second;
+			}
+
+			// Finds the triangle containing point, starting at the last created triangle. Returns a half-edge of it; if the
+			// point lies on an edge, that half-edge.
+			std::uint32_t locate(sf::Vector2f point)
+			{
+				std::uint32_t triangle = mLastTriangle;
+				std::uint32_t entry = None;
+
+				for (;;)
+				{
+					// Start with a random edge, so that the walk cannot cycle
+					mRandom ^= mRandom << 13;
+					mRandom ^= mRandom >> 17;
+					mRandom ^= mRandom << 5;
+
+					std::uint32_t crossed = None;
+					for (std::uint32_t k = 0; k < 3; ++k)
+					{
+						std::uint32_t halfEdge = 3 * triangle + (mRandom + k) % 3;
+						if (halfEdge == entry)
+							continue;
+
+						if (orientation(position(corner(halfEdge)), position(corner(next(halfEdge))), point) < 0.0
+						 && mHalfEdges[halfEdge] != None)
+						{
+							crossed = halfEdge;
+							break;
+						}
+					}
+
+					if (crossed == None)
+						break;
+
+					entry = mHalfEdges[crossed];
+					triangle = entry / 3;
+				}
+
+				for (std::uint32_t i = 0; i < 3; ++i)
+				{
+					std::uint32_t halfEdge = 3 * triangle + i;
+					if (orientation(position(corner(halfEdge)), position(corner(next(halfEdge))), point) == 0.0)
+						return halfEdge;
+				}
+				return 3 * triangle;
+			}
+
+			void insertVertex(std::uint32_t vertex)
+			{
+				sf::Vector2f point = position(vertex);
+				std::uint32_t halfEdge = locate(point);
+				std::uint32_t triangle = halfEdge / 3;
+
+				// Duplicate points are merged into the first one
+				for (std::uint32_t i = 0; i < 3; ++i)
+				{
+					if (position(corner(3 * triangle + i)) == point)
+					{
+						mVertexMap[vertex] = corner(3 * triangle + i);
+						return;
+					}
+				}
+
+				if (orientation(position(corner(halfEdge)), position(corner(next(halfEdge))), point) == 0.0)
+					splitEdge(halfEdge, vertex);
+				else
+					splitTriangle(triangle, vertex);
+
+				legalize();
+			}
+
+			// Replaces triangle abc by abv, bcv and cav.
+			void splitTriangle(std::uint32_t t0, std::uint32_t v)
+			{
+				std::uint32_t a = corner(3 * t0 + 0), b = corner(3 * t0 + 1), c = corner(3 * t0 + 2);
+				std::uint32_t ab = mHalfEdges[3 * t0 + 0], bc = mHalfEdges[3 * t0 + 1], ca = mHalfEdges[3 * t0 + 2];
+				std::uint8_t abConstrained = mConstrained[3 * t0 + 0];
+				std::uint8_t bcConstrained = mConstrained[3 * t0 + 1];
+				std::uint8_t caConstrained = mConstrained[3 * t0 + 2];
+
+				std::uint32_t t1 = addTriangle();
+				std::uint32_t t2 = addTriangle();
+				setCorners(t0, a, b, v);
+				setCorners(t1, b, c, v);
+				setCorners(t2, c, a, v);
+
+				link(3 * t0 + 0, ab, abConstrained);
+				link(3 * t1 + 0, bc, bcConstrained);
+				link(3 * t2 + 0, ca, caConstrained);
+				link(3 * t0 + 1, 3 * t1 + 2);
+				link(3 * t1 + 1, 3 * t2 + 2);
+				link(3 * t2 + 1, 3 * t0 + 2);
+
+				// The edges opposite to the new vertex may violate the Delaunay condition
+				mFlipStack.push_back(3 * t0);
+				mFlipStack.push_back(3 * t1);
+				mFlipStack.push_back(3 * t2);
+				mLastTriangle = t0;
+			}
+
+			// Splits the edge ab of triangle abc and its neighbor bad at the vertex v, which lies on the edge.
+			void splitEdge(std::uint32_t halfEdge, std::uint32_t v)
+			{
+				std::uint32_t t0 = halfEdge / 3;
+				std::uint32_t a = corner(halfEdge), b = corner(next(halfEdge)), c = corner(prev(halfEdge));
+				std::uint32_t bc = mHalfEdges[next(halfEdge)], ca = mHalfEdges[prev(halfEdge)];
+				std::uint8_t bcConstrained = mConstrained[next(halfEdge)];
+				std::uint8_t caConstrained = mConstrained[prev(halfEdge)];
+				std::uint8_t abConstrained = mConstrained[halfEdge];
+				std::uint32_t opposite = mHalfEdges[halfEdge];
+
+				std::uint32_t t1 = addTriangle();
+				setCorners(t0, c, a, v);
+				setCorners(t1, b, c, v);
+				link(3 * t0 + 0, ca, caConstrained);
+				link(3 * t1 + 0, bc, bcConstrained);
+				link(3 * t0 + 2, 3 * t1 + 1);
+				mFlipStack.push_back(3 * t0);
+				mFlipStack.push_back(3 * t1);
+
+				if (opposite == None)
+				{
+					link(3 * t0 + 1, None, abConstrained);
+					link(3 * t1 + 2, None, abConstrained);
+				}
+				else
+				{
+					std::uint32_t t2 = opposite / 3;
+					std::uint32_t d = corner(prev(opposite));
+					std::uint32_t ad = mHalfEdges[next(opposite)], db = mHalfEdges[prev(opposite)];
+					std::uint8_t adConstrained = mConstrained[next(opposite)];
+					std::uint8_t dbConstrained = mConstrained[prev(opposite)];
+
+					std::uint32_t t3 = addTriangle();
+					setCorners(t2, d, b, v);
+					setCorners(t3, a, d, v);
+					link(3 * t2 + 0, db, dbConstrained);
+					link(3 * t3 + 0, ad, adConstrained);
+					link(3 * t2 + 2, 3 * t3 + 1);
+					link(3 * t0 + 1, 3 * t3 + 2, abConstrained);
+					link(3 * t1 + 2, 3 * t2 + 1, abConstrained);
+					mFlipStack.push_back(3 * t2);
+					mFlipStack.push_back(3 * t3);
+				}
+
+				mLastTriangle = t0;
+			}
+
+			// Replaces the edge ab between the triangles abc and bad by the edge cd. Afterwards, the triangles are adc and dbc,
+			// so the first half-edges of both are the ones that were opposite to c.
+			void flip(std::uint32_t halfEdge)
+			{
+				std::uint32_t opposite = mHalfEdges[halfEdge];
+				std::uint32_t t0 = halfEdge / 3;
+				std::uint32_t t1 = opposite / 3;
+
+				std::uint32_t a = corner(halfEdge), b = corner(next(halfEdge)), c = corner(prev(halfEdge));
+				std::uint32_t d = corner(prev(opposite));
+				std::uint32_t bc = mHalfEdges[next(halfEdge)], ca = mHalfEdges[prev(halfEdge)];
+				std::uint32_t ad = mHalfEdges[next(opposite)], db = mHalfEdges[prev(opposite)];
+				std::uint8_t bcConstrained = mConstrained[next(halfEdge)];
+				std::uint8_t caConstrained = mConstrained[prev(halfEdge)];
+				std::uint8_t adConstrained = mConstrained[next(opposite)];
+				std::uint8_t dbConstrained = mConstrained[prev(opposite)];
+
+				setCorners(t0, a, d, c);
+				setCorners(t1, d, b, c);
+				link(3 * t0 + 0, ad, adConstrained);
+				link(3 * t0 + 2, ca, caConstrained);
+				link(3 * t1 + 0, db, dbConstrained);
+				link(3 * t1 + 1, bc, bcConstrained);
+				link(3 * t0 + 1, 3 * t1 + 2);
+			}
+
+			// Returns whether the two triangles at the half-edge form a strictly convex quadrilateral, so that the edge can be flipped.
+			bool isFlippable(std::uint32_t halfEdge) const
+			{
+				sf::Vector2f c = position(corner(prev(halfEdge)));
+				sf::Vector2f d = position(corner(prev(mHalfEdges[halfEdge])));
+				double oa = orientation(c, d, position(corner(halfEdge)));
+				double ob = orientation(c, d, position(corner(next(halfEdge))));
+				return (oa > 0.0 && ob < 0.0) || (oa < 0.0 && ob > 0.0);
+			}
+
+			// Flips the edges on the stack until all edges opposite to the inserted vertex are locally Delaunay.
+			// The predicates are exact, so an edge failing the circle test always has a convex quadrilateral.
+			void legalize()
+			{
+				while (!mFlipStack.empty())
+				{
+					std::uint32_t halfEdge = mFlipStack.back();
+					mFlipStack.pop_back();
+
+					std::uint32_t opposite = mHalfEdges[halfEdge];
+					if (opposite == None || mConstrained[halfEdge])
+						continue;
+
+					if (inCircle(position(corner(halfEdge)), position(corner(next(halfEdge))), position(corner(prev(halfEdge))),
+						position(corner(prev(opposite)))) > 0.0)
+					{
+						flip(halfEdge);
+						mFlipStack.push_back(3 * (halfEdge / 3));
+						mFlipStack.push_back(3 * (opposite / 3));
+					}
+				}
+			}
+
+			// Returns the half-edge from a to b, or None if a and b are not connected.
+			std::uint32_t findEdge(std::uint32_t a, std::uint32_t b) const
+			{
+				// Rotate around a in one direction, and if the boundary is hit, in the other one
+				std::uint32_t start = mVertexEdges[a];
+				std::uint32_t halfEdge = start;
+				do
+				{
+					if (corner(next(halfEdge)) == b)
+						return halfEdge;
+
+					halfEdge = mHalfEdges[prev(halfEdge)];
+				}
+				while (halfEdge != None && halfEdge != start);
+
+				if (halfEdge == None)
+				{
+					halfEdge = start;
+					while (mHalfEdges[halfEdge] != None)
+					{
+						halfEdge = next(mHalfEdges[halfEdge]);
+						if (halfEdge == start)
+							break;
+						if (corner(next(halfEdge)) == b)
+							return halfEdge;
+					}
+				}
+
+				return None;
+			}
+
+			// Returns whether the edge cd crosses the segment from start to end in its interior.
+			bool crossesSegment(std::uint32_t c, std::uint32_t d, std::uint32_t start, std::uint32_t end) const
+			{
+				if (c == start || c == end || d == start || d == end)
+					return false;
+
+				double oc = orientation(position(start), position(end), position(c));
+				double od = orientation(position(start), position(end), position(d));
+				return (oc > 0.0 && od < 0.0) || (oc < 0.0 && od > 0.0);
+			}
+
+			void insertConstrainedEdge(std::uint32_t start, std::uint32_t end)
+			{
+				// Edges running through other vertices are split at those vertices
+				mPendingEdges.assign(1, std::make_pair(start, end));
+				while (!mPendingEdges.empty())
+				{
+					start = mPendingEdges.back().first;
+					end = mPendingEdges.back().second;
+					mPendingEdges.pop_back();
+
+					if (start == end)
+						continue;
+
+					std::uint32_t existing = findEdge(start, end);
+					if (existing != None)
+					{
+						link(existing, mHalfEdges[existing], 1);
+						continue;
+					}
+
+					std::uint32_t through = collectCrossedEdges(start, end);
+					if (through != None)
+					{
+						mPendingEdges.push_back(std::make_pair(through, end));
+						end = through;
+					}
+
+					removeCrossedEdges(start, end);
+				}
+			}
+
+			// Stores the edges crossed by the segment from start to end in mCrossedEdges, as pairs of vertices.
+			// If the segment runs through a vertex, stops there and returns the vertex; otherwise returns None.
+			std::uint32_t collectCrossedEdges(std::uint32_t start, std::uint32_t end)
+			{
+				mCrossedEdges.clear();
+				sf::Vector2f from = position(start);
+				sf::Vector2f to = position(end);
+
+				// Find the triangle around start that the segment leaves through its opposite edge
+				std::uint32_t halfEdge = mVertexEdges[start];
+				for (;;)
+				{
+					std::uint32_t b = corner(next(halfEdge));
+					std::uint32_t c = corner(prev(halfEdge));
+					double ob = orientation(from, to, position(b));
+					double oc = orientation(from, to, position(c));
+
+					if (ob == 0.0 && dotProduct(position(b) - from, to - from) > 0.f)
+						return b;
+					if (oc == 0.0 && dotProduct(position(c) - from, to - from) > 0.f)
+						return c;
+					if (ob < 0.0 && oc > 0.0)
+						break;
+
+					// Only reached if the edge runs outside the triangulation: leave it unconstrained
+					halfEdge = mHalfEdges[prev(halfEdge)];
+					if (halfEdge == None || halfEdge == mVertexEdges[start])
+						return None;
+				}
+
+				// Walk along the segment; the crossed edge always runs from the right side to the left side
+				std::uint32_t crossed = next(halfEdge);
+				for (;;)
+				{
+					std::uint32_t right = corner(crossed);
+					std::uint32_t left = corner(next(crossed));
+					mCrossedEdges.push_back(std::make_pair(left, right));
+
+					std::uint32_t opposite = mHalfEdges[crossed];
+					assert(opposite != None);
+
+					std::uint32_t d = corner(prev(opposite));
+					if (d == end)
+						return None;
+
+					double od = orientation(from, to, position(d));
+					if (od == 0.0)
+						return d;
+
+					crossed = (od > 0.0) ? next(opposite) : prev(opposite);
+				}
+			}
+
+			// Flips the edges in mCrossedEdges until the segment from start to end is an edge, then marks it as constrained.
+			void removeCrossedEdges(std::uint32_t start, std::uint32_t end)
+			{
+				mNewEdges.clear();
+
+				// Edges that cannot be flipped yet, because their quadrilateral is not convex, are retried later
+				for (std::size_t i = 0; i < mCrossedEdges.size(); ++i)
+				{
+					std::uint32_t halfEdge = findEdge(mCrossedEdges[i].first, mCrossedEdges[i].second);
+					assert(halfEdge != None);
+
+					std::uint32_t c = corner(prev(halfEdge));
+					std::uint32_t d = corner(prev(mHalfEdges[halfEdge]));
+					if (isFlippable(halfEdge))
+					{
+						flip(halfEdge);
+						if (crossesSegment(c, d, start, end))
+							mCrossedEdges.push_back(std::make_pair(c, d));
+						else
+							mNewEdges.push_back(std::make_pair(c, d));
+					}
+					else
+					{
+						mCrossedEdges.push_back(mCrossedEdges[i]);
+					}
+				}
+
+				std::uint32_t constrained = findEdge(start, end);
+				if (constrained == None)
+					return;
+
+				link(constrained, mHalfEdges[constrained], 1);
+
+				// Restore the Delaunay condition for the new edges, except for the constrained one
+				bool flipped = true;
+				while (flipped)
+				{
+					flipped = false;
+					for (std::size_t i = 0; i < mNewEdges.size(); ++i)
+					{
+						std::uint32_t halfEdge = findEdge(mNewEdges[i].first, mNewEdges[i].second);
+						if (halfEdge == None || mConstrained[halfEdge] || mHalfEdges[halfEdge] == None)
+							continue;
+
+						std::uint32_t c = corner(prev(halfEdge));
+						std::uint32_t d = corner(prev(mHalfEdges[halfEdge]));
+						if (inCircle(position(corner(halfEdge)), position(corner(next(halfEdge))), position(c), position(d)) > 0.0)
+						{
+							flip(halfEdge);
+							mNewEdges[i] = std::make_pair(c, d);
+							flipped = true;
+						}
+					}
+				}
+			}
+
+			// Fills mResult with the triangles in the region that do not touch the boundary triangle.
+			template <typename EdgeVector>
+			void collectTriangles(std::uint32_t pointCount, const EdgeVector& constrainedEdges, Region region)
+			{
+				const std::uint32_t triangleCount = static_cast<std::uint32_t>(mCorners.size() / 3);
+
+				ArenaVector<std::uint8_t> removed(triangleCount, 0, mArena);
+				ArenaVector<std::uint32_t> front(mArena);
+				for (std::uint32_t t = 0; t < triangleCount; ++t)
+				{
+					if (corner(3 * t) >= pointCount || corner(3 * t + 1) >= pointCount || corner(3 * t + 2) >= pointCount)
+					{
+						removed[t] = 1;
+						front.push_back(t);
+					}
+				}
+
+				// The flood below starts outside for a polygon, and on the left sides of the edges otherwise
+				if (region == RightOfEdges)
+				{
+					front.clear();
+					for (std::size_t i = 0; i + 1 < constrainedEdges.size(); i += 2)
+					{
+						// The triangle of a half-edge is on its left; edges split at collinear vertices are not found
+						std::uint32_t halfEdge = findEdge(mVertexMap[constrainedEdges[i]], mVertexMap[constrainedEdges[i + 1]]);
+						if (halfEdge != None && !removed[halfEdge / 3])
+						{
+							removed[halfEdge / 3] = 1;
+							front.push_back(halfEdge / 3);
+						}
+					}
+				}
+
+				// Everything that can be reached without crossing a constrained edge is removed
+				if (region != ConvexHull)
+				{
+					while (!front.empty())
+					{
+						std::uint32_t t = front.back();
+						front.pop_back();
+
+						for (std::uint32_t halfEdge = 3 * t; halfEdge < 3 * t + 3; ++halfEdge)
+						{
+							std::uint32_t opposite = mHalfEdges[halfEdge];
+							if (opposite != None && !mConstrained[halfEdge] && !removed[opposite / 3])
+							{
+								removed[opposite / 3] = 1;
+								front.push_back(opposite / 3);
+							}
+						}
+					}
+				}
+
+				mResult.reserve(3 * triangleCount);
+				mResultTriangles.reserve(triangleCount);
+				for (std::uint32_t t = 0; t < triangleCount; ++t)
+				{
+					if (removed[t])
+						continue;
+
+					mResultTriangles.push_back(t);
+
+					// The mesh is counter-clockwise, thor::Triangle is clockwise
+					mResult.push_back(corner(3 * t + 0));
+					mResult.push_back(corner(3 * t + 2));
+					mResult.push_back(corner(3 * t + 1));
+				}
+			}
 
 		private:
-			// Sorts the corners by vector-component-sum to allow faster access inside std::set.
-			void						orderCorners();
+			MemoryArena*											mArena;
+			ArenaVector<sf::Vector2f>								mPoints;
+			ArenaVector<std::uint32_t>								mCorners;
+			ArenaVector<std::uint32_t>								mHalfEdges;
+			ArenaVector<std::uint8_t>								mConstrained;
+			// An outgoing half-edge of every vertex
+			ArenaVector<std::uint32_t>								mVertexEdges;
+			// Vertex that represents each point (differs only for duplicates)
+			ArenaVector<std::uint32_t>								mVertexMap;
+			ArenaVector<std::uint32_t>								mResult;
+			// Mesh triangle of every result triangle
+			ArenaVector<std::uint32_t>								mResultTriangles;
+
+			ArenaVector<std::uint32_t>								mFlipStack;
+			ArenaVector<std::pair<std::uint32_t, std::uint32_t>>	mCrossedEdges;
+			ArenaVector<std::pair<std::uint32_t, std::uint32_t>>	mNewEdges;
+			// Parts of the constrained edge being inserted
+			ArenaVector<std::pair<std::uint32_t, std::uint32_t>>	mPendingEdges;
+			std::uint32_t											mLastTriangle = 0;
+			std::uint32_t											mRandom = 2463534242u;
 	};
 
-	// A triangle that carries advanced information in order to efficiently support the algorithm.
-	class THOR_API AdvancedTriangle : public Triangle<AdvancedVertex>
+	// ---------------------------------------------------------------------------------------------------------------------------
+
+
+	// Delaunay triangulation on several threads.
+	// The points are split into strips across the longer side of their bounding box, and every strip is triangulated by its
+	// own thread. A triangle whose circumcircle lies inside its strip contains no point of another strip, so it belongs to the
+	// triangulation of all points ("final"). The vertices of the other triangles and of the strips' convex hulls are then
+	// triangulated once more, with the outlines of the final regions as constrained edges. The final regions lie to the left
+	// of their outlines; the triangles of this seam mesh that lie to the right fill the gaps between them.
+	class ParallelDelaunay
 	{
 		public:
-										AdvancedTriangle(AdvancedVertex& corner0, AdvancedVertex& corner1, AdvancedVertex& corner2);
+			// Triangulates the points with up to threadCount threads.
+			void triangulate(const std::vector<sf::Vector2f>& points, unsigned int threadCount)
+			{
+				mPoints = &points;
+				mResult.clear();
+
+				// Every strip should have enough points that its inside outweighs its seams
+				const std::uint32_t pointCount = static_cast<std::uint32_t>(points.size());
+				const std::uint32_t stripCount = std::max(1u, std::min<std::uint32_t>(threadCount, pointCount / 1024));
+				if (stripCount == 1)
+				{
+					DelaunayMesh mesh;
+					mesh.triangulate(points, std::vector<std::uint32_t>(), DelaunayMesh::ConvexHull);
+					mResult.assign(mesh.getTriangles().begin(), mesh.getTriangles().end());
+					return;
+				}
+
+				createStrips(stripCount);
+
+				mSeam.assign(pointCount, 0);
+				std::vector<std::thread> threads;
+				for (std::size_t i = 1; i < mStrips.size(); ++i)
+					threads.push_back(std::thread(&ParallelDelaunay::triangulateStrip, this, std::ref(mStrips[i])));
+
+				triangulateStrip(mStrips[0]);
+				AURORA_FOREACH(std::thread& thread, threads)
+					thread.join();
+
+				triangulateSeams();
+			}
 
-			void						addVertex(AdvancedVertex& vertexRef);
+			// Returns the triangles as three indices into the points each, in clockwise order.
+			const std::vector<std::uint32_t>& getTriangles() const
+			{
+				return mResult;
+			}
 
-			void						removeVertex(AdvancedVertex& vertexRef);
-			void						removeVertex(VertexPtrIterator vertexItr);
+		private:
+			struct Strip
+			{
+				// Indices of the points in the strip
+				std::vector<std::uint32_t>		points;
+				// Range of the strip's coordinates along the split axis; points of other strips lie outside
+				double							min;
+				double							max;
+				// Final triangles, clockwise like the output
+				std::vector<std::uint32_t>		triangles;
+				// Directed edges of the final regions' outlines, counter-clockwise around them
+				std::vector<std::uint32_t>		outline;
+			};
+
+			float coordinate(std::uint32_t point) const
+			{
+				return mSplitAlongY ? (*mPoints)[point].y : (*mPoints)[point].x;
+			}
 
-			VertexPtrIterator			begin();
-			VertexPtrIterator			end();
+			void createStrips(std::uint32_t stripCount)
+			{
+				const std::vector<sf::Vector2f>& points = *mPoints;
+				const std::uint32_t pointCount = static_cast<std::uint32_t>(points.size());
+
+				sf::Vector2f min = points[0];
+				sf::Vector2f max = points[0];
+				AURORA_FOREACH(sf::Vector2f point, points)
+				{
+					min.x = std::min(min.x, point.x);
+					min.y = std::min(min.y, point.y);
+					max.x = std::max(max.x, point.x);
+					max.y = std::max(max.y, point.y);
+				}
+
+				// Cutting across the longer side keeps the seams short
+				mSplitAlongY = max.y - min.y > max.x - min.x;
+				float low = mSplitAlongY ? min.y : min.x;
+				float extent = mSplitAlongY ? max.y - min.y : max.x - min.x;
+
+				// Cut between the bins of a histogram of the coordinates, so that the strips get about the same number of points
+				const std::uint32_t binCount = 4096;
+				float scale = extent > 0.f ? binCount / extent : 0.f;
+				auto binOf = [&] (std::uint32_t point)
+				{
+					return std::min(binCount - 1, static_cast<std::uint32_t>((coordinate(point) - low) * scale));
+				};
+
+				std::vector<std::uint32_t> histogram(binCount, 0);
+				for (std::uint32_t i = 0; i < pointCount; ++i)
+					++histogram[binOf(i)];
+
+				std::vector<std::uint32_t> stripOfBin(binCount);
+				std::uint32_t strip = 0;
+				std::uint64_t count = 0;
+				for (std::uint32_t bin = 0; bin < binCount; ++bin)
+				{
+					if (strip + 1 < stripCount && count >= std::uint64_t(pointCount) * (strip + 1) / stripCount)
+						++strip;
+
+					stripOfBin[bin] = strip;
+					count += histogram[bin];
+				}
+
+				// The first and last strips are open to the outside
+				mStrips.assign(stripCount, Strip());
+				AURORA_FOREACH(Strip& strip, mStrips)
+				{
+					strip.min = std::numeric_limits<double>::infinity();
+					strip.max = -std::numeric_limits<double>::infinity();
+				}
+
+				for (std::uint32_t i = 0; i < pointCount; ++i)
+				{
+					Strip& strip = mStrips[stripOfBin[binOf(i)]];
+					strip.points.push_back(i);
+					strip.min = std::min(strip.min, double(coordinate(i)));
+					strip.max = std::max(strip.max, double(coordinate(i)));
+				}
+
+				mStrips.erase(std::remove_if(mStrips.begin(), mStrips.end(), [] (const Strip& strip) { return strip.points.empty(); }),
+					mStrips.end());
+				mStrips.front().min = -std::numeric_limits<double>::infinity();
+				mStrips.back().max = std::numeric_limits<double>::infinity();
+			}
+
+			// Returns whether the circumcircle of the triangle lies inside the strip, with a margin for rounding errors.
+			bool isFinal(const Strip& strip, sf::Vector2f a, sf::Vector2f b, sf::Vector2f c) const
+			{
+				double bx = double(b.x) - a.x, by = double(b.y) - a.y;
+				double cx = double(c.x) - a.x, cy = double(c.y) - a.y;
+				double denominator = 2.0 * (bx * cy - by * cx);
+				if (denominator == 0.0)
+					return false;
+
+				double b2 = bx * bx + by * by;
+				double c2 = cx * cx + cy * cy;
+				double ux = (cy * b2 - by * c2) / denominator;
+				double uy = (bx * c2 - cx * b2) / denominator;
+
+				double radius = std::sqrt(ux * ux + uy * uy);
+				double center = mSplitAlongY ? a.y + uy : a.x + ux;
+				double margin = 1e-6 * (std::abs(center) + radius);
+
+				return center - radius > strip.min + margin && center + radius < strip.max - margin;
+			}
 
-			// Sets/returns the adjacent triangle on the opposite side of the corner #index.
-			void						setAdjacentTriangle(std::size_t index, const OptTriangleIterator& adjacentTriangle);
-			OptTriangleIterator			getAdjacentTriangle(std::size_t index) const;
+			// Triangulates a strip, keeps its final triangles and outlines, and marks the points of the seam mesh.
+			// Runs concurrently for different strips; every strip only writes to its own points in mSeam.
+			void triangulateStrip(Strip& strip)
+			{
+				const std::vector<sf::Vector2f>& points = *mPoints;
+
+				std::vector<sf::Vector2f> positions(strip.points.size());
+				for (std::size_t i = 0; i < strip.points.size(); ++i)
+					positions[i] = points[strip.points[i]];
+
+				DelaunayMesh mesh;
+				mesh.triangulate(positions, std::vector<std::uint32_t>(), DelaunayMesh::ConvexHull);
+				const ArenaVector<std::uint32_t>& triangles = mesh.getTriangles();
+
+				// Without triangles (e.g. collinear points), everything is left to the seam mesh
+				if (triangles.empty())
+				{
+					AURORA_FOREACH(std::uint32_t point, strip.points)
+						mSeam[point] = 1;
+					return;
+				}
+
+				const std::uint32_t triangleCount = static_cast<std::uint32_t>(triangles.size() / 3);
+				std::vector<std::uint8_t> finals(triangleCount);
+				for (std::uint32_t t = 0; t < triangleCount; ++t)
+				{
+					const std::uint32_t* corners = &triangles[3 * t];
+					finals[t] = isFinal(strip, positions[corners[0]], positions[corners[1]], positions[corners[2]]);
+
+					if (finals[t])
+					{
+						for (std::uint32_t k = 0; k < 3; ++k)
+							strip.triangles.push_back(strip.points[corners[k]]);
+					}
+					else
+					{
+						for (std::uint32_t k = 0; k < 3; ++k)
+							mSeam[strip.points[corners[k]]] = 1;
+					}
+				}
+
+				std::vector<std::uint32_t> neighbors;
+				mesh.getNeighbors(neighbors);
+				for (std::uint32_t t = 0; t < triangleCount; ++t)
+				{
+					for (std::uint32_t k = 0; k < 3; ++k)
+					{
+						std::uint32_t from = strip.points[triangles[3 * t + k]];
+						std::uint32_t to = strip.points[triangles[3 * t + (k + 1) % 3]];
+						std::uint32_t neighbor = neighbors[3 * t + k];
+
+						// Edges without a neighbor are on the convex hull of the strip
+						if (neighbor == DelaunayMesh::None)
+						{
+							mSeam[from] = 1;
+							mSeam[to] = 1;
+						}
+
+						// Edges between final and other triangles enclose the final regions; reversed, they have them on the left
+						if (finals[t] && (neighbor == DelaunayMesh::None || !finals[neighbor]))
+						{
+							strip.outline.push_back(to);
+							strip.outline.push_back(from);
+						}
+					}
+				}
+			}
 
-			// Marks this triangle (or removes mark)
-			void						setFlagged(bool flagged);
-			bool						isFlagged() const;
+			// Triangulates the marked points between the final regions and gathers the result.
+			void triangulateSeams()
+			{
+				const std::vector<sf::Vector2f>& points = *mPoints;
+
+				std::vector<std::uint32_t> seamPoints;
+				std::vector<std::uint32_t> seamIndices(points.size(), DelaunayMesh::None);
+				std::vector<sf::Vector2f> positions;
+				for (std::uint32_t i = 0; i < points.size(); ++i)
+				{
+					if (mSeam[i])
+					{
+						seamIndices[i] = static_cast<std::uint32_t>(seamPoints.size());
+						seamPoints.push_back(i);
+						positions.push_back(points[i]);
+					}
+				}
+
+				std::vector<std::uint32_t> outline;
+				AURORA_FOREACH(const Strip& strip, mStrips)
+				{
+					AURORA_FOREACH(std::uint32_t point, strip.outline)
+						outline.push_back(seamIndices[point]);
+				}
+
+				DelaunayMesh mesh;
+				mesh.triangulate(positions, outline, DelaunayMesh::RightOfEdges);
+				const ArenaVector<std::uint32_t>& triangles = mesh.getTriangles();
+
+				std::size_t size = triangles.size();
+				AURORA_FOREACH(const Strip& strip, mStrips)
+					size += strip.triangles.size();
+
+				mResult.reserve(size);
+				AURORA_FOREACH(const Strip& strip, mStrips)
+					mResult.insert(mResult.end(), strip.triangles.begin(), strip.triangles.end());
+				AURORA_FOREACH(std::uint32_t vertex, triangles)
+					mResult.push_back(seamPoints[vertex]);
+			}
 
 		private:
-			VertexPtrSet							mRemainingVertices;
-			aurora::CopiedPtr<OptTriangleItrArray>	mAdjacentTriangles;
-			bool									mFlagged;
+			const std::vector<sf::Vector2f>*						mPoints = nullptr;
+			bool													mSplitAlongY = false;
+			std::vector<Strip>										mStrips;
+			// Whether each point is a vertex of the seam mesh
+			std::vector<std::uint8_t>								mSeam;
+			std::vector<std::uint32_t>								mResult;
 	};
 
 	// ---------------------------------------------------------------------------------------------------------------------------
 
 
-	// Type definitions of containers
-	typedef std::deque<AdvancedVertex>						VertexCtr;
-	typedef std::set<AdvancedEdge, CompareEdges>			EdgeSet;
-	typedef std::list<AdvancedTriangle>						TriangleList;
+	// Constrained Delaunay triangulation of small simple polygons, without dynamic memory.
+	// The polygon is cut into triangles by ear clipping, which also links adjacent triangles. Then all inner edges are flipped
+	// until they are locally Delaunay; since the polygon edges are the only constraints, this yields the same triangulation as
+	// DelaunayMesh with InsidePolygon. Triangles and half-edges follow the conventions of DelaunayMesh.
+	class SmallPolygonTriangulation
+	{
+		public:
+			// Maximal number of vertices; larger polygons are faster with DelaunayMesh anyway
+			enum { Capacity = 64 };
 
-	// Type definitions of often used iterators
-	typedef TriangleList::iterator							TriangleIterator;
+		private:
+			enum : std::uint8_t { None = 0xFF };
+			enum { MaxHalfEdges = 3 * (Capacity - 2) };
 
-	// ---------------------------------------------------------------------------------------------------------------------------
+		public:
+			// Triangulates the polygon with the given vertices. Returns false if ear clipping gets stuck, which happens for
+			// polygons that are not simple, or that contain coinciding or collinear points in an unfortunate place.
+			bool triangulate(const sf::Vector2f* points, std::uint32_t pointCount)
+			{
+				assert(pointCount <= Capacity);
 
+				mPoints = points;
+				mTriangleCount = 0;
+				if (pointCount < 3)
+					return true;
 
-	// Iterator to a triangle which can be explicitly invalid ("opt" stands for "optional").
-	struct THOR_API OptTriangleIterator
-	{
-									OptTriangleIterator();
-									OptTriangleIterator(TriangleIterator target);
-									OptTriangleIterator(const OptTriangleIterator& origin);
-		OptTriangleIterator&		operator= (const OptTriangleIterator& origin);
+				if (!clipEars(pointCount))
+					return false;
 
-		bool						valid;
-		TriangleIterator			target;
-	};
+				legalize();
+				return true;
+			}
 
-	// Circle class, needed for circumcircle
-	struct Circle
-	{
-									Circle(sf::Vector2f midPoint, float squaredRadius);
+			std::uint32_t getTriangleCount() const
+			{
+				return mTriangleCount;
+			}
 
-		sf::Vector2f				midPoint;
-		float						squaredRadius;
-	};
+			// Returns the index of a triangle corner. The corners of every triangle are in clockwise order.
+			std::uint32_t getCorner(std::uint32_t triangle, std::uint32_t cornerIndex) const
+			{
+				return mCorners[3 * triangle + 2 - cornerIndex];
+			}
 
-	// Metafunction to get a CV-qualified iterator value type (std::iterator_traits<T>::value_type is not const)
-	template <typename T>
-	struct DereferencedIterator
-	{
-		typedef typename std::remove_pointer<
-			typename std::iterator_traits<T>::pointer
-		>::type value_type;
-	};
+		private:
+			static std::uint32_t next(std::uint32_t halfEdge)
+			{
+				return halfEdge % 3 == 2 ? halfEdge - 2 : halfEdge + 1;
+			}
 
-	// ---------------------------------------------------------------------------------------------------------------------------
+			static std::uint32_t prev(std::uint32_t halfEdge)
+			{
+				return halfEdge % 3 == 0 ? halfEdge + 2 : halfEdge - 1;
+			}
 
+			sf::Vector2f position(std::uint32_t vertex) const
+			{
+				return mPoints[vertex];
+			}
 
-	template <typename V>
-	AdvancedVertex::AdvancedVertex(V& userVertex, OptTriangleIterator surroundingTriangle)
-	: mUserVertex(const_cast<typename std::remove_const<V>::type*>(&userVertex))
-	, mPosition(getVertexPosition(userVertex))
-	, mSurroundingTriangle(aurora::makeCopied<OptTriangleIterator>(surroundingTriangle))
-#ifndef NDEBUG
-	, mUserType(&typeid(V))
-#endif
-	{
-	}
+			void setCorners(std::uint32_t triangle, std::uint32_t v0, std::uint32_t v1, std::uint32_t v2)
+			{
+				mCorners[3 * triangle + 0] = static_cast<std::uint8_t>(v0);
+				mCorners[3 * triangle + 1] = static_cast<std::uint8_t>(v1);
+				mCorners[3 * triangle + 2] = static_cast<std::uint8_t>(v2);
+			}
 
-	template <typename V>
-	V& AdvancedVertex::getUserVertex() const
-	{
-		assert(typeid(V) == *mUserType);
-		return *static_cast<V*>(mUserVertex);
-	}
+			// Makes two half-edges opposite to each other.
+			void link(std::uint32_t halfEdge, std::uint32_t opposite)
+			{
+				mHalfEdges[halfEdge] = static_cast<std::uint8_t>(opposite);
+				if (opposite != None)
+					mHalfEdges[opposite] = static_cast<std::uint8_t>(halfEdge);
+			}
 
-	// ---------------------------------------------------------------------------------------------------------------------------
+			// Whether the vertex, with its current neighbors in the remaining polygon, is not strictly convex.
+			bool isReflex(std::uint32_t vertex) const
+			{
+				return thor::orientation(position(mPrevVertex[vertex]), position(vertex), position(mNextVertex[vertex])) <= 0.0;
+			}
 
+			// Whether the triangle at the vertex can be cut off: it is strictly convex and contains no other vertex. Only
+			// reflex vertices can be inside, as the polygon is simple.
+			bool isEar(std::uint32_t vertex, std::uint32_t remainingCount) const
+			{
+				if (mReflex[vertex])
+					return false;
+
+				std::uint32_t p = mPrevVertex[vertex];
+				std::uint32_t n = mNextVertex[vertex];
+				sf::Vector2f a = position(p), b = position(vertex), c = position(n);
+
+				std::uint32_t other = mNextVertex[n];
+				for (std::uint32_t i = 3; i < remainingCount; ++i, other = mNextVertex[other])
+				{
+					if (mReflex[other]
+					 && thor::orientation(a, b, position(other)) >= 0.0
+					 && thor::orientation(b, c, position(other)) >= 0.0
+					 && thor::orientation(c, a, position(other)) >= 0.0)
+						return false;
+				}
+
+				return true;
+			}
 
-	// Function declarations required by the header
-	void 				THOR_API insertPoint(TriangleList& triangles, AdvancedVertex& vertex, const AdvancedTriangle& boundaryTriangle,
-									const EdgeSet& constrainedEdges);
+			// Cuts off ears until one triangle remains. The polygon is traversed counter-clockwise, so the triangles are
+			// counter-clockwise, too.
+			bool clipEars(std::uint32_t pointCount)
+			{
+				// The lowest-leftmost vertex is convex, so its orientation is the one of the polygon
+				std::uint32_t lowest = 0;
+				for (std::uint32_t i = 1; i < pointCount; ++i)
+				{
+					if (position(i).x < position(lowest).x || (position(i).x == position(lowest).x && position(i).y < position(lowest).y))
+						lowest = i;
+				}
+
+				double polygonOrientation = thor::orientation(
+					position((lowest + pointCount - 1) % pointCount), position(lowest), position((lowest + 1) % pointCount));
+				if (polygonOrientation == 0.0)
+					return false;
+
+				for (std::uint32_t i = 0; i < pointCount; ++i)
+				{
+					std::uint32_t before = (i + pointCount - 1) % pointCount;
+					std::uint32_t after = (i + 1) % pointCount;
+					if (polygonOrientation < 0.0)
+						std::swap(before, after);
+
+					mPrevVertex[i] = static_cast<std::uint8_t>(before);
+					mNextVertex[i] = static_cast<std::uint8_t>(after);
+
+					// The polygon edges are not adjacent to any triangle yet
+					mOuterEdge[i] = None;
+				}
+
+				for (std::uint32_t i = 0; i < pointCount; ++i)
+					mReflex[i] = isReflex(i);
+
+				// Cut off the ear at vertex, and link the new triangle to the ones cut off before. Afterwards, the edge from
+				// the previous to the next vertex is on the polygon, with the new triangle outside.
+				std::uint32_t vertex = lowest;
+				std::uint32_t remainingCount = pointCount;
+				std::uint32_t unsuccessfulCount = 0;
+
+				while (remainingCount > 3)
+				{
+					if (!isEar(vertex, remainingCount))
+					{
+						vertex = mNextVertex[vertex];
+						if (++unsuccessfulCount > remainingCount)
+							return false;
+
+						continue;
+					}
+
+					std::uint32_t p = mPrevVertex[vertex];
+					std::uint32_t n = mNextVertex[vertex];
+					addTriangle(p, vertex, n);
+
+					mNextVertex[p] = static_cast<std::uint8_t>(n);
+					mPrevVertex[n] = static_cast<std::uint8_t>(p);
+					mReflex[p] = isReflex(p);
+					mReflex[n] = isReflex(n);
+
+					vertex = n;
+					--remainingCount;
+					unsuccessfulCount = 0;
+				}
+
+				if (mReflex[vertex])
+					return false;
+
+				// The last triangle closes the remaining polygon, so its third edge is a polygon edge, too
+				std::uint32_t n = mNextVertex[vertex];
+				std::uint32_t outerEdge = mOuterEdge[n];
+				addTriangle(mPrevVertex[vertex], vertex, n);
+				link(3 * (mTriangleCount - 1) + 2, outerEdge);
+				return true;
+			}
 
-	void				THOR_API removeUnusedTriangles(TriangleList& triangles, const AdvancedTriangle& boundaryTriangle,
-									const EdgeSet& constrainedEdges, bool limitToPolygon);
+			// Adds the triangle (p, v, n), where p, v, n are consecutive on the remaining polygon.
+			void addTriangle(std::uint32_t p, std::uint32_t v, std::uint32_t n)
+			{
+				std::uint32_t triangle = mTriangleCount++;
+				setCorners(triangle, p, v, n);
 
-	void 				THOR_API createBoundaryPoints(VertexCtr& allVertices, TriangleList& triangles);
+				link(3 * triangle + 0, mOuterEdge[p]);
+				link(3 * triangle + 1, mOuterEdge[v]);
+				mHalfEdges[3 * triangle + 2] = None;
+				mOuterEdge[p] = static_cast<std::uint8_t>(3 * triangle + 2);
+			}
 
-	void 				THOR_API setBoundaryPositions(const VertexCtr& allVertices, AdvancedTriangle& boundaryTriangle);
+			// Replaces the edge ab between the triangles abc and bad by the edge cd. Afterwards, the triangles are adc and dbc.
+			void flip(std::uint32_t halfEdge)
+			{
+				std::uint32_t opposite = mHalfEdges[halfEdge];
+				std::uint32_t t0 = halfEdge / 3;
+				std::uint32_t t1 = opposite / 3;
+
+				std::uint32_t a = mCorners[halfEdge], b = mCorners[next(halfEdge)], c = mCorners[prev(halfEdge)];
+				std::uint32_t d = mCorners[prev(opposite)];
+				std::uint32_t bc = mHalfEdges[next(halfEdge)], ca = mHalfEdges[prev(halfEdge)];
+				std::uint32_t ad = mHalfEdges[next(opposite)], db = mHalfEdges[prev(opposite)];
+
+				setCorners(t0, a, d, c);
+				setCorners(t1, d, b, c);
+				link(3 * t0 + 0, ad);
+				link(3 * t0 + 2, ca);
+				link(3 * t1 + 0, db);
+				link(3 * t1 + 1, bc);
+				link(3 * t0 + 1, 3 * t1 + 2);
+			}
+
+			// Flips inner edges until all of them are locally Delaunay. Every half-edge is on the stack at most once, which
+			// bounds its size. The predicates are exact, so an edge failing the circle test always has a convex quadrilateral.
+			void legalize()
+			{
+				const std::uint32_t halfEdgeCount = 3 * mTriangleCount;
+
+				std::uint8_t stack[MaxHalfEdges];
+				bool onStack[MaxHalfEdges];
+				std::uint32_t stackSize = 0;
+
+				for (std::uint32_t i = 0; i < halfEdgeCount; ++i)
+				{
+					onStack[i] = mHalfEdges[i] != None && mHalfEdges[i] < i;
+					if (onStack[i])
+						stack[stackSize++] = static_cast<std::uint8_t>(i);
+				}
+
+				auto push = [&] (std::uint32_t halfEdge)
+				{
+					if (mHalfEdges[halfEdge] != None && !onStack[halfEdge])
+					{
+						onStack[halfEdge] = true;
+						stack[stackSize++] = static_cast<std::uint8_t>(halfEdge);
+					}
+				};
+
+				while (stackSize > 0)
+				{
+					std::uint32_t halfEdge = stack[--stackSize];
+					onStack[halfEdge] = false;
+
+					// Flips may have moved a polygon edge to this position
+					std::uint32_t opposite = mHalfEdges[halfEdge];
+					if (opposite == None)
+						continue;
+
+					if (thor::inCircle(position(mCorners[halfEdge]), position(mCorners[next(halfEdge)]), position(mCorners[prev(halfEdge)]),
+						position(mCorners[prev(opposite)])) > 0.0)
+					{
+						std::uint32_t t0 = halfEdge / 3;
+						std::uint32_t t1 = opposite / 3;
+						flip(halfEdge);
+
+						push(3 * t0 + 0);
+						push(3 * t0 + 2);
+						push(3 * t1 + 0);
+						push(3 * t1 + 1);
+					}
+				}
+			}
+
+		private:
+			const sf::Vector2f*		mPoints;
+			std::uint32_t			mTriangleCount;
+			std::uint8_t			mCorners[MaxHalfEdges];
+			std::uint8_t			mHalfEdges[MaxHalfEdges];
+
+			// Remaining polygon during ear clipping, and the half-edge outside of the polygon edge from each vertex
+			std::uint8_t			mPrevVertex[Capacity];
+			std::uint8_t			mNextVertex[Capacity];
+			std::uint8_t			mOuterEdge[Capacity];
+			bool					mReflex[Capacity];
+	};
 
 	// ---------------------------------------------------------------------------------------------------------------------------
 
@@ -241,189 +1375,144 @@ namespace detail
 	// ---------------------------------------------------------------------------------------------------------------------------
 
 
-	// Returns the position of a user vertex.
-	template <typename V>
-	sf::Vector2f getVertexPosition(const V& vertex)
+	// Writes the polygon edges, if requested by the policy.
+	template <typename UserVertex>
+	void outputPolygonEdges(UserVertex* const*, std::uint32_t, const PolygonTrDetails&)
 	{
-		return TriangulationTraits<V>::getPosition(vertex);
 	}
 
-	// Sort out vertices according to their "importance". Vertices that are part of a constrained edge shall be inserted first.
-	// Adds constrained edges as well.
-	template <typename InputIterator1, typename InputIterator2>
-	void collateVerticesConstrained(TriangleIterator firstTriangle, VertexCtr& allVertices, EdgeSet& constrainedEdges,
-		InputIterator1 verticesBegin, InputIterator1 verticesEnd, InputIterator2 constrainedEdgesBegin, InputIterator2 constrainedEdgesEnd)
+	template <typename UserVertex, typename OutputIterator>
+	void outputPolygonEdges(UserVertex* const* userVertices, std::uint32_t count, const PolygonOutputTrDetails<OutputIterator, UserVertex>& details)
 	{
-		typedef typename DereferencedIterator<InputIterator1>::value_type UserVertex;
-		typedef typename std::iterator_traits<InputIterator2>::value_type UserEdge;
-		typedef std::set<UserVertex*> RawVertexPtrSet;
-
-		// Store pointers to important vertices in importantVertices set
-		RawVertexPtrSet importantVertices;
-		for (InputIterator2 itr = constrainedEdgesBegin; itr != constrainedEdgesEnd; ++itr)
-		{
-			UserEdge& edge = *itr;
-
-			importantVertices.insert(&edge[0]);
-			importantVertices.insert(&edge[1]);
-		}
-
-		// Insert important advanced vertices, link to base triangle, fill user->advanced map
-		std::map<UserVertex*, AdvancedVertex*> map;
-		AURORA_FOREACH(UserVertex* userVertex, importantVertices)
-		{
-			allVertices.push_back(AdvancedVertex(*userVertex, firstTriangle));
+		OutputIterator edgesOut = details.edgesOut;
+		for (std::uint32_t i = 0; count > 1 && i < count; ++i)
+			*edgesOut++ = Edge<UserVertex>(*userVertices[i], *userVertices[(i + 1) % count]);
+	}
 
-			AdvancedVertex& advancedVertex = allVertices.back();
-			firstTriangle->addVertex(advancedVertex);
+	// Converts the constrained edges to pairs of vertex indices.
+	template <typename UserVertex, typename InputIterator>
+	void collectConstrainedEdges(const ArenaVector<UserVertex*>& userVertices, ArenaVector<std::uint32_t>& constrainedEdges,
+		const ConstrainedTrDetails<InputIterator>& details)
+	{
+		if (details.constrainedEdgesBegin == details.constrainedEdgesEnd)
+			return;
 
-			map.insert(std::make_pair(userVertex, &advancedVertex));
-		}
+		// Sorted address -> index table, to find the vertices the edges refer to
+		ArenaVector<std::pair<const void*, std::uint32_t>> indices(userVertices.size(), std::pair<const void*, std::uint32_t>(),
+			userVertices.get_allocator());
+		for (std::size_t i = 0; i < userVertices.size(); ++i)
+			indices[i] = std::make_pair(static_cast<const void*>(userVertices[i]), static_cast<std::uint32_t>(i));
+		std::sort(indices.begin(), indices.end());
 
-		// Insert advanced edges, using the user->advanced map
-		for (InputIterator2 itr = constrainedEdgesBegin; itr != constrainedEdgesEnd; ++itr)
+		auto indexOf = [&indices] (const void* vertex) -> std::uint32_t
 		{
-			UserEdge& userEdge = *itr;
-
-			AdvancedEdge advancedEdge(*map[&userEdge[0]], *map[&userEdge[1]]);
-			constrainedEdges.insert(advancedEdge);
-		}
+			auto found = std::lower_bound(indices.begin(), indices.end(), std::make_pair(vertex, std::uint32_t(0)));
+			assert(found != indices.end() && found->first == vertex);
+			return found->second;
+		};
 
-		// Insert other vertices, link to base triangle
-		for (; verticesBegin != verticesEnd; ++verticesBegin)
+		for (InputIterator itr = details.constrainedEdgesBegin; itr != details.constrainedEdgesEnd; ++itr)
 		{
-			UserVertex& userVertex = *verticesBegin;
-
-			if (importantVertices.find(&userVertex) == importantVertices.end())
-			{
-				allVertices.push_back(detail::AdvancedVertex(userVertex, firstTriangle));
-				firstTriangle->addVertex(allVertices.back());
-			}
+			constrainedEdges.push_back(indexOf(&(*itr)[0]));
+			constrainedEdges.push_back(indexOf(&(*itr)[1]));
 		}
 	}
 
-	// Helper function for collateVerticesPolygon(); constructs an edge and adds it to the container and output iterator.
-	inline void addEdge(EdgeSet& constrainedEdges, AdvancedVertex* previousVertex, AdvancedVertex& currentVertex,
-		PolygonTrDetails)
+	// Overload for PolygonTrDetails: consecutive vertices form the edges
+	template <typename UserVertex>
+	void collectConstrainedEdges(const ArenaVector<UserVertex*>& userVertices, ArenaVector<std::uint32_t>& constrainedEdges,
+		const PolygonTrDetails&)
 	{
-		if (previousVertex != nullptr)
-			constrainedEdges.insert(AdvancedEdge(*previousVertex, currentVertex));
-	}
-
-	// Overload for PolygonOutputTrDetails to write in an output iterator
-	template <typename OutputIterator, typename UserVertex>
-	void addEdge(EdgeSet& constrainedEdges, AdvancedVertex* previousVertex, AdvancedVertex& currentVertex,
-		PolygonOutputTrDetails<OutputIterator, UserVertex> details)
-	{
-		if (previousVertex != nullptr)
+		std::uint32_t count = static_cast<std::uint32_t>(userVertices.size());
+		for (std::uint32_t i = 0; count > 1 && i < count; ++i)
 		{
-			*details.edgesOut++ = Edge<UserVertex>(
-				previousVertex->getUserVertex<UserVertex>(),
-				currentVertex.getUserVertex<UserVertex>());
-
-			constrainedEdges.insert(AdvancedEdge(*previousVertex, currentVertex));
+			constrainedEdges.push_back(i);
+			constrainedEdges.push_back((i + 1) % count);
 		}
 	}
 
-	// collateVertices() - Implementation for polygons
-	template <typename InputIterator, class AdditionalDetails>
-	void collateVerticesPolygon(TriangleIterator firstTriangle, VertexCtr& allVertices, EdgeSet& constrainedEdges,
-		InputIterator verticesBegin, InputIterator verticesEnd, const AdditionalDetails& details)
+	// Overload for PolygonOutputTrDetails: consecutive vertices form the edges, which are written to the output iterator
+	template <typename UserVertex, typename OutputIterator>
+	void collectConstrainedEdges(const ArenaVector<UserVertex*>& userVertices, ArenaVector<std::uint32_t>& constrainedEdges,
+		const PolygonOutputTrDetails<OutputIterator, UserVertex>& details)
 	{
-		// Empty vertex range: Do nothing
-		if (verticesBegin == verticesEnd)
-			return;
+		collectConstrainedEdges(userVertices, constrainedEdges, PolygonTrDetails());
+		outputPolygonEdges(userVertices.data(), static_cast<std::uint32_t>(userVertices.size()), details);
+	}
 
-		AdvancedVertex* previousVertex = nullptr;
+	// Triangulates with temporary memory from arena, or from the heap if it is null
+	template <typename InputIterator, typename OutputIterator, class AdditionalDetails>
+	OutputIterator triangulateImpl(InputIterator verticesBegin, InputIterator verticesEnd, OutputIterator trianglesOut, const AdditionalDetails& details,
+		MemoryArena* arena)
+	{
+		typedef typename DereferencedIterator<InputIterator>::value_type UserVertex;
 
+		// Flat copies of the positions, the mesh only refers to vertices by index
+		const std::size_t vertexCount = static_cast<std::size_t>(std::distance(verticesBegin, verticesEnd));
+		ArenaVector<UserVertex*> userVertices(arena);
+		ArenaVector<sf::Vector2f> positions(arena);
+		userVertices.reserve(vertexCount);
+		positions.reserve(vertexCount);
 		for (; verticesBegin != verticesEnd; ++verticesBegin)
 		{
-			// Add the vertex to allVertices, link with firstTriangle
-			allVertices.push_back(AdvancedVertex(*verticesBegin, firstTriangle));
-			AdvancedVertex& vertex = allVertices.back();
-			firstTriangle->addVertex(vertex);
-
-			// Add edge of adjacent vertices
-			addEdge(constrainedEdges, previousVertex, vertex, details);
-			previousVertex = &vertex;
+			UserVertex& vertex = *verticesBegin;
+			userVertices.push_back(&vertex);
+			positions.push_back(getVertexPosition(vertex));
 		}
 
-		// If at least one vertex is contained, insert edge from last to first vertex, so that the boundary is closed.
-		// First vertex is the one directly inserted after the three boundary vertices.
-		AdvancedVertex& firstVertex = allVertices[3];
-		addEdge(constrainedEdges, previousVertex, firstVertex, details);
-	}
-
-	// Indirect overload for ConstrainedTrDetail<InputIterator2>
-	template <typename InputIterator1, typename InputIterator2>
-	void collateVertices(TriangleIterator firstTriangle, VertexCtr& allVertices, EdgeSet& constrainedEdges,
-		InputIterator1 verticesBegin, InputIterator1 verticesEnd, const ConstrainedTrDetails<InputIterator2>& details)
-	{
-		collateVerticesConstrained(firstTriangle, allVertices, constrainedEdges, verticesBegin, verticesEnd,
-			details.constrainedEdgesBegin, details.constrainedEdgesEnd);
-	}
-
-	// Indirect overload for PolygonTrDetails
-	template <typename InputIterator>
-	void collateVertices(TriangleIterator firstTriangle, VertexCtr& allVertices, EdgeSet& constrainedEdges,
-		InputIterator verticesBegin, InputIterator verticesEnd, const PolygonTrDetails& details)
-	{
-		collateVerticesPolygon(firstTriangle, allVertices, constrainedEdges, verticesBegin, verticesEnd, details);
-	}
+		ArenaVector<std::uint32_t> constrainedEdges(arena);
+		collectConstrainedEdges(userVertices, constrainedEdges, details);
 
-	// Indirect overload for PolygonOutputTrDetails
-	template <typename InputIterator, typename OutputIterator, typename UserVertex>
-	void collateVertices(TriangleIterator firstTriangle, VertexCtr& allVertices, EdgeSet& constrainedEdges,
-		InputIterator verticesBegin, InputIterator verticesEnd, const PolygonOutputTrDetails<OutputIterator, UserVertex>& details)
-	{
-		collateVerticesPolygon(firstTriangle, allVertices, constrainedEdges, verticesBegin, verticesEnd, details);
-	}
+		DelaunayMesh mesh(arena);
+		mesh.triangulate(positions, constrainedEdges, AdditionalDetails::isPolygon ? DelaunayMesh::InsidePolygon : DelaunayMesh::ConvexHull);
 
-	template <typename UserVertex, typename InputIterator, typename OutputIterator>
-	OutputIterator transformTriangles(InputIterator begin, InputIterator end, OutputIterator out)
-	{
-		for (; begin != end; ++begin)
+		// Transform from indices to the user interface
+		const ArenaVector<std::uint32_t>& triangles = mesh.getTriangles();
+		for (std::size_t i = 0; i < triangles.size(); i += 3)
 		{
-			const AdvancedTriangle& current = *begin;
-
-			// Downcast to original vertex type (during the algorithm, we abandoned full type information)
-			*out++ = Triangle<UserVertex>(
-				current[0].getUserVertex<UserVertex>(),
-				current[1].getUserVertex<UserVertex>(),
-				current[2].getUserVertex<UserVertex>());
+			*trianglesOut++ = Triangle<UserVertex>(
+				*userVertices[triangles[i + 0]],
+				*userVertices[triangles[i + 1]],
+				*userVertices[triangles[i + 2]]);
 		}
 
-		return out;
+		return trianglesOut;
 	}
 
+	// Like triangulateImpl(), but triangulates small polygons on the stack
 	template <typename InputIterator, typename OutputIterator, class AdditionalDetails>
-	OutputIterator triangulateImpl(InputIterator verticesBegin, InputIterator verticesEnd, OutputIterator trianglesOut, const AdditionalDetails& details)
+	OutputIterator triangulatePolygonImpl(InputIterator verticesBegin, InputIterator verticesEnd, OutputIterator trianglesOut, const AdditionalDetails& details,
+		MemoryArena* arena)
 	{
-		// Create container for all vertices with additional implementation data (allVertices) and for triangles
-		VertexCtr		allVertices;
-		TriangleList	triangles;
-		EdgeSet			constrainedEdges;
+		typedef typename DereferencedIterator<InputIterator>::value_type UserVertex;
 
-		// Avoid reallocations (and thus iterator and reference invalidations), add first three boundary (dummy, as they're removed afterwards) vertices
-		createBoundaryPoints(allVertices, triangles);
-		AdvancedTriangle boundaryTriangle = triangles.front();
+		UserVertex* userVertices[SmallPolygonTriangulation::Capacity];
+		sf::Vector2f positions[SmallPolygonTriangulation::Capacity];
+		std::uint32_t count = 0;
 
-		// Bring vertices in ideal order for constrained Delaunay triangulation, and add constrained edges
-		collateVertices(triangles.begin(), allVertices, constrainedEdges, verticesBegin, verticesEnd, details);
+		InputIterator itr = verticesBegin;
+		for (; itr != verticesEnd && count < SmallPolygonTriangulation::Capacity; ++itr, ++count)
+		{
+			UserVertex& vertex = *itr;
+			userVertices[count] = &vertex;
+			positions[count] = getVertexPosition(vertex);
+		}
 
-		// Set the positions of the boundary vertices, according to the spread of the internal vertices
-		setBoundaryPositions(allVertices, boundaryTriangle);
+		SmallPolygonTriangulation triangulation;
+		if (itr != verticesEnd || !triangulation.triangulate(positions, count))
+			return triangulateImpl(verticesBegin, verticesEnd, trianglesOut, details, arena);
 
-		// Insert each vertex. This invalidates the iterator first (because the old triangle is removed (split)).
-		for (VertexCtr::iterator itr = allVertices.begin() + 3, end = allVertices.end(); itr != end; ++itr)
-			insertPoint(triangles, *itr, boundaryTriangle, constrainedEdges);
+		outputPolygonEdges(userVertices, count, details);
 
-		// Remove triangles that are not contained in the final triangulation
-		removeUnusedTriangles(triangles, boundaryTriangle, constrainedEdges, AdditionalDetails::isPolygon);
+		for (std::uint32_t i = 0; i < triangulation.getTriangleCount(); ++i)
+		{
+			*trianglesOut++ = Triangle<UserVertex>(
+				*userVertices[triangulation.getCorner(i, 0)],
+				*userVertices[triangulation.getCorner(i, 1)],
+				*userVertices[triangulation.getCorner(i, 2)]);
+		}
 
-		// Transform from algorithm-specific data structures to user interface
-		typedef typename DereferencedIterator<InputIterator>::value_type UserVertex;
-		return transformTriangles<UserVertex>(triangles.begin(), triangles.end(), trianglesOut);
+		return trianglesOut;
 	}
 
 } // namespace detail
@@ -441,26 +1530,88 @@ OutputIterator triangulate(InputIterator verticesBegin, InputIterator verticesEn
 	return triangulateConstrained(verticesBegin, verticesEnd, noEdges.begin(), noEdges.end(), trianglesOut);
 }
 
+template <typename InputIterator, typename OutputIterator>
+OutputIterator triangulate(MemoryArena& arena, InputIterator verticesBegin, InputIterator verticesEnd, OutputIterator trianglesOut)
+{
+	typedef typename detail::DereferencedIterator<InputIterator>::value_type UserVertex;
+
+	std::vector<Edge<UserVertex>> noEdges;
+	return triangulateConstrained(arena, verticesBegin, verticesEnd, noEdges.begin(), noEdges.end(), trianglesOut);
+}
+
+template <typename InputIterator, typename OutputIterator>
+OutputIterator triangulateParallel(InputIterator verticesBegin, InputIterator verticesEnd, OutputIterator trianglesOut,
+	unsigned int threadCount)
+{
+	typedef typename detail::DereferencedIterator<InputIterator>::value_type UserVertex;
+
+	std::vector<UserVertex*> userVertices;
+	std::vector<sf::Vector2f> positions;
+	for (; verticesBegin != verticesEnd; ++verticesBegin)
+	{
+		UserVertex& vertex = *verticesBegin;
+		userVertices.push_back(&vertex);
+		positions.push_back(detail::getVertexPosition(vertex));
+	}
+
+	detail::ParallelDelaunay triangulation;
+	triangulation.triangulate(positions, threadCount);
+
+	const std::vector<std::uint32_t>& triangles = triangulation.getTriangles();
+	for (std::size_t i = 0; i < triangles.size(); i += 3)
+	{
+		*trianglesOut++ = Triangle<UserVertex>(
+			*userVertices[triangles[i + 0]],
+			*userVertices[triangles[i + 1]],
+			*userVertices[triangles[i + 2]]);
+	}
+
+	return trianglesOut;
+}
+
 template <typename InputIterator1, typename InputIterator2, typename OutputIterator>
 OutputIterator triangulateConstrained(InputIterator1 verticesBegin, InputIterator1 verticesEnd,
 	InputIterator2 constrainedEdgesBegin, InputIterator2 constrainedEdgesEnd, OutputIterator trianglesOut)
 {
 	return detail::triangulateImpl(verticesBegin, verticesEnd, trianglesOut,
-		detail::ConstrainedTrDetails<InputIterator2>(constrainedEdgesBegin, constrainedEdgesEnd));
+		detail::ConstrainedTrDetails<InputIterator2>(constrainedEdgesBegin, constrainedEdgesEnd), nullptr);
+}
+
+template <typename InputIterator1, typename InputIterator2, typename OutputIterator>
+OutputIterator triangulateConstrained(MemoryArena& arena, InputIterator1 verticesBegin, InputIterator1 verticesEnd,
+	InputIterator2 constrainedEdgesBegin, InputIterator2 constrainedEdgesEnd, OutputIterator trianglesOut)
+{
+	return detail::triangulateImpl(verticesBegin, verticesEnd, trianglesOut,
+		detail::ConstrainedTrDetails<InputIterator2>(constrainedEdgesBegin, constrainedEdgesEnd), &arena);
 }
 
 template <typename InputIterator, typename OutputIterator>
 OutputIterator triangulatePolygon(InputIterator verticesBegin, InputIterator verticesEnd, OutputIterator trianglesOut)
 {
-	return detail::triangulateImpl(verticesBegin, verticesEnd, trianglesOut,
-		detail::PolygonTrDetails());
+	return detail::triangulatePolygonImpl(verticesBegin, verticesEnd, trianglesOut,
+		detail::PolygonTrDetails(), nullptr);
+}
+
+template <typename InputIterator, typename OutputIterator>
+OutputIterator triangulatePolygon(MemoryArena& arena, InputIterator verticesBegin, InputIterator verticesEnd, OutputIterator trianglesOut)
+{
+	return detail::triangulatePolygonImpl(verticesBegin, verticesEnd, trianglesOut,
+		detail::PolygonTrDetails(), &arena);
 }
 
 template <typename InputIterator, typename OutputIterator1, typename OutputIterator2>
 OutputIterator1 triangulatePolygon(InputIterator verticesBegin, InputIterator verticesEnd, OutputIterator1 trianglesOut, OutputIterator2 edgesOut)
 {
-	return detail::triangulateImpl(verticesBegin, verticesEnd, trianglesOut,
-		detail::PolygonOutputTrDetails<OutputIterator2, typename detail::DereferencedIterator<InputIterator>::value_type>(edgesOut));
+	return detail::triangulatePolygonImpl(verticesBegin, verticesEnd, trianglesOut,
+		detail::PolygonOutputTrDetails<OutputIterator2, typename detail::DereferencedIterator<InputIterator>::value_type>(edgesOut), nullptr);
+}
+
+template <typename InputIterator, typename OutputIterator1, typename OutputIterator2>
+OutputIterator1 triangulatePolygon(MemoryArena& arena, InputIterator verticesBegin, InputIterator verticesEnd, OutputIterator1 trianglesOut,
+	OutputIterator2 edgesOut)
+{
+	return detail::triangulatePolygonImpl(verticesBegin, verticesEnd, trianglesOut,
+		detail::PolygonOutputTrDetails<OutputIterator2, typename detail::DereferencedIterator<InputIterator>::value_type>(edgesOut), &arena);
 }
 
 } // namespace thor
@@ -0,0 +1,117 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2015 Jan Haller
+// 
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+// 
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+// 
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+/// @file
+/// @brief Class thor::MemoryArena
+
+#ifndef THOR_MEMORYARENA_HPP
+#define THOR_MEMORYARENA_HPP
+
+#include <Aurora/Tools/NonCopyable.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+
+namespace thor
+{
+
+/// @addtogroup Math
+/// @{
+
+/// @brief Monotonic memory arena for temporary data
+/// @details Allocating is a pointer increment within a large chunk of memory. Nothing is released individually; reset() releases
+///  all allocations at once. If more than one chunk was needed since the last reset, reset() replaces them by a single chunk that
+///  is big enough for all of them, so that repeated work of similar size no longer touches the heap.
+///  @n The triangulation functions and thor::ConcaveShape accept an arena, from which they then take all their temporary memory.
+///  The arena is not thread-safe.
+class MemoryArena : private aurora::NonCopyable
+{
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Public member functions
+	public:
+		/// @brief Constructor
+		/// @param chunkSize Size of the first chunk in bytes.
+		explicit					MemoryArena(std::size_t chunkSize = 64 * 1024);
+
+		/// @brief Returns uninitialized memory of the given size.
+		/// @param size Number of bytes.
+		/// @param alignment Alignment of the memory, must be a power of two.
+		void*						allocate(std::size_t size, std::size_t alignment);
+
+		/// @brief Releases all allocations at once.
+		///
+		void						reset();
+
+		/// @brief Returns the number of bytes handed out since the last reset().
+		///
+		std::size_t					getBytesUsed() const;
+
+		/// @brief Returns the number of allocate() calls since the last reset().
+		///
+		std::size_t					getAllocationCount() const;
+
+		/// @brief Returns the number of chunks taken from the heap since construction.
+		///
+		std::size_t					getChunkAllocationCount() const;
+
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Private types
+	private:
+		struct Chunk
+		{
+			std::unique_ptr<char[]>	memory;
+			std::size_t				size;
+		};
+
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Private member functions
+	private:
+		void						addChunk(std::size_t size);
+
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Private variables
+	private:
+		std::vector<Chunk>			mChunks;
+		std::size_t					mOffset;
+		std::size_t					mBytesUsed;
+		std::size_t					mAllocationCount;
+		std::size_t					mChunkAllocationCount;
+};
+
+/// @}
+
+} // namespace thor
+
+#include <Thor/Math/Detail/MemoryArena.inl>
+#endif // THOR_MEMORYARENA_HPP
@@ -0,0 +1,66 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2015 Jan Haller
+// 
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+// 
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+// 
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+/// @file
+/// @brief Exact geometric predicates thor::orientation() and thor::inCircle()
+
+#ifndef THOR_PREDICATES_HPP
+#define THOR_PREDICATES_HPP
+
+#include <Thor/Config.hpp>
+
+#include <SFML/System/Vector2.hpp>
+
+#include <cmath>
+#include <cstdint>
+
+
+namespace thor
+{
+
+/// @addtogroup Math
+/// @{
+
+/// @brief Orientation test of three points
+/// @details Returns a positive value if @a a, @a b and @a c are in counter-clockwise order in a coordinate system with the Y axis
+///  pointing up (clockwise on the screen), a negative value if they are in the other order, and zero if they are collinear.
+///  The magnitude is approximately twice the area of the triangle.
+///  @n The sign is always exact. The determinant is computed in double precision first; only if the rounding error could have
+///  changed its sign, it is evaluated again with exact arithmetic. The exact path uses no dynamic memory.
+double						orientation(sf::Vector2f a, sf::Vector2f b, sf::Vector2f c);
+
+/// @brief In-circle test of four points
+/// @details If @a a, @a b and @a c are in counter-clockwise order (orientation() returns a positive value), returns a positive value
+///  if @a d lies inside their circumcircle, a negative value if it lies outside, and zero if the four points are co-circular.
+///  For clockwise @a a, @a b and @a c, the sign is reversed.
+///  @n The sign is always exact, as for orientation().
+double						inCircle(sf::Vector2f a, sf::Vector2f b, sf::Vector2f c, sf::Vector2f d);
+
+/// @}
+
+} // namespace thor
+
+#include <Thor/Math/Detail/Predicates.inl>
+#endif // THOR_PREDICATES_HPP
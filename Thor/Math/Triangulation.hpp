@@ -32,20 +32,24 @@
 #include <SFML/System/Vector2.hpp>
 
 #include <Thor/Math/TriangulationFigures.hpp>
+#include <Thor/Math/MemoryArena.hpp>
+#include <Thor/Math/Predicates.hpp>
+
+#include <Thor/Vectors/VectorAlgebra2D.hpp>
 
 #include <Aurora/Tools/ForEach.hpp>
-#include <Aurora/SmartPtr/CopiedPtr.hpp>
 
-#include <vector>
-#include <deque>
-#include <list>
-#include <set>
-#include <map>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <functional>
 #include <iterator>
+#include <limits>
+#include <thread>
 #include <type_traits>
-#ifndef NDEBUG
- #include <typeinfo> // for detail::AdvancedVertex::getUserVertex<V>()
-#endif
+#include <utility>
+#include <vector>
 
 
 namespace thor
@@ -59,7 +63,8 @@ namespace thor
 ///  the own three points. This condition leads to a "beautiful" result, the triangles appear balanced.
 /// @param verticesBegin,verticesEnd Iterator range to the points being triangulated. The element type V can be any type as long as
 ///  thor::TriangulationTraits<V> is specialized.
-///  @n Note that the triangulation may meet problems at 4 co-circular points or at 3 or more collinear points.
+///  @n The geometric tests are exact, so co-circular and collinear points are handled consistently. Of 4 co-circular points,
+///  either diagonal may become an edge.
 /// @param trianglesOut Output iterator which is used to store the computed triangles. The elements shall be of type @ref thor::Triangle "thor::Triangle<V>",
 ///  where V is your (maybe const-qualified) vertex type. The resulting triangles reference the original vertices in [verticesBegin, verticesEnd[, so they must
 ///  not be destroyed as long as you access the triangles.
@@ -68,12 +73,27 @@ namespace thor
 template <typename InputIterator, typename OutputIterator>
 OutputIterator				triangulate(InputIterator verticesBegin, InputIterator verticesEnd, OutputIterator trianglesOut);
 
+/// @brief Parallel Delaunay Triangulation
+/// @details Computes the same triangulation as triangulate(), using several threads. The points are split into strips that are
+///  triangulated concurrently, after which the seams between them are triangulated on the calling thread. This pays off for large
+///  point sets; with fewer than about a thousand points per thread, fewer threads are used.
+/// @param verticesBegin,verticesEnd Iterator range to the points being triangulated. The element type V can be any type as long as
+///  thor::TriangulationTraits<V> is specialized.
+/// @param trianglesOut Output iterator which is used to store the computed triangles. The elements shall be of type @ref thor::Triangle "thor::Triangle<V>",
+///  where V is your (maybe const-qualified) vertex type. The triangles are written in no particular order.
+/// @param threadCount Maximal number of threads, including the calling one.
+/// @return Output iterator after the last element written.
+template <typename InputIterator, typename OutputIterator>
+OutputIterator				triangulateParallel(InputIterator verticesBegin, InputIterator verticesEnd, OutputIterator trianglesOut,
+								unsigned int threadCount);
+
 /// @brief Constrained Delaunay Triangulation
 /// @details Performs a Delaunay triangulation while taking constraining edges into account. "Constrained" means edges
 ///  which are supposed to be part of the triangulation, locally ignoring the Delaunay condition.
 /// @param verticesBegin,verticesEnd Iterator range to the points being triangulated. The element type V can be any type as long as
 ///  thor::TriangulationTraits<V> is specialized.
-///  @n Note that the triangulation may meet problems at 4 co-circular points or at 3 or more collinear points.
+///  @n The geometric tests are exact, so co-circular and collinear points are handled consistently. Of 4 co-circular points,
+///  either diagonal may become an edge.
 /// @param constrainedEdgesBegin,constrainedEdgesEnd Iterator range to the constrained edges. The element type shall be @ref thor::Edge "thor::Edge<V>",
 ///  where T specifies your vertex type. The edges must refer to vertices inside the range [verticesBegin, verticesEnd[.
 ///  To get expected results, edges may not intersect (except at the end points; containing the same vertex is allowed).
@@ -88,6 +108,9 @@ OutputIterator				triangulateConstrained(InputIterator1 verticesBegin, InputIter
 
 /// @brief Polygon Delaunay Triangulation
 /// @details Computes a Delaunay triangulation of the inside of a polygon.
+///  @n Polygons with up to 64 vertices are triangulated by ear clipping followed by edge flips, which leads to the same triangles
+///  without allocating dynamic memory. Writing to @a trianglesOut is then the only allocation, if any (none for a std::vector with
+///  enough reserved capacity). Larger polygons, and ones that ear clipping cannot handle, use the general algorithm.
 /// @param verticesBegin,verticesEnd Iterator range to the points being triangulated. The element type V can be any type as long as
 ///  thor::TriangulationTraits<V> is specialized. The order of the vertices is important, as the constrained edges are formed between consecutive
 ///  points (and between the last and first point). If the vertices lead to crossing edges, the result is undefined.
@@ -101,6 +124,9 @@ OutputIterator				triangulatePolygon(InputIterator verticesBegin, InputIterator
 
 /// @brief Polygon Delaunay Triangulation
 /// @details Computes a Delaunay triangulation of the inside of a polygon.
+///  @n Polygons with up to 64 vertices are triangulated by ear clipping followed by edge flips, which leads to the same triangles
+///  without allocating dynamic memory. Writing to @a trianglesOut is then the only allocation, if any (none for a std::vector with
+///  enough reserved capacity). Larger polygons, and ones that ear clipping cannot handle, use the general algorithm.
 /// @param verticesBegin,verticesEnd Iterator range to the points being triangulated. The element type V can be any type as long as
 ///  thor::TriangulationTraits<V> is specialized. The order of the vertices is important, as the constrained edges are formed between consecutive
 ///  points (and between the last and first point). If the vertices lead to crossing edges, the result is undefined.
@@ -115,6 +141,33 @@ OutputIterator				triangulatePolygon(InputIterator verticesBegin, InputIterator
 template <typename InputIterator, typename OutputIterator1, typename OutputIterator2>
 OutputIterator1				triangulatePolygon(InputIterator verticesBegin, InputIterator verticesEnd, OutputIterator1 trianglesOut, OutputIterator2 edgesOut);
 
+/// @brief Delaunay Triangulation with temporary memory from an arena
+/// @details Same as triangulate(verticesBegin, verticesEnd, trianglesOut), but all temporary memory is taken from @a arena instead of
+///  the heap, so that a triangulation needs only a few allocations. The arena is not reset; the function does not use the memory
+///  anymore after returning.
+template <typename InputIterator, typename OutputIterator>
+OutputIterator				triangulate(MemoryArena& arena, InputIterator verticesBegin, InputIterator verticesEnd, OutputIterator trianglesOut);
+
+/// @brief Constrained Delaunay Triangulation with temporary memory from an arena
+/// @details Same as triangulateConstrained(verticesBegin, verticesEnd, constrainedEdgesBegin, constrainedEdgesEnd, trianglesOut),
+///  but all temporary memory is taken from @a arena instead of the heap.
+template <typename InputIterator1, typename InputIterator2, typename OutputIterator>
+OutputIterator				triangulateConstrained(MemoryArena& arena, InputIterator1 verticesBegin, InputIterator1 verticesEnd,
+								InputIterator2 constrainedEdgesBegin, InputIterator2 constrainedEdgesEnd, OutputIterator trianglesOut);
+
+/// @brief Polygon Delaunay Triangulation with temporary memory from an arena
+/// @details Same as triangulatePolygon(verticesBegin, verticesEnd, trianglesOut), but all temporary memory is taken from @a arena
+///  instead of the heap.
+template <typename InputIterator, typename OutputIterator>
+OutputIterator				triangulatePolygon(MemoryArena& arena, InputIterator verticesBegin, InputIterator verticesEnd, OutputIterator trianglesOut);
+
+/// @brief Polygon Delaunay Triangulation with temporary memory from an arena
+/// @details Same as triangulatePolygon(verticesBegin, verticesEnd, trianglesOut, edgesOut), but all temporary memory is taken
+///  from @a arena instead of the heap.
+template <typename InputIterator, typename OutputIterator1, typename OutputIterator2>
+OutputIterator1				triangulatePolygon(MemoryArena& arena, InputIterator verticesBegin, InputIterator verticesEnd, OutputIterator1 trianglesOut,
+								OutputIterator2 edgesOut);
+
 /// @}
 
 } // namespace thor
@@ -30,9 +30,13 @@
 #define THOR_MODULE_RESOURCES_HPP
 
 #include <Thor/Resources/OwnershipModels.hpp>
+#include <Thor/Resources/StorageModels.hpp>
 #include <Thor/Resources/KnownIdStrategy.hpp>
 #include <Thor/Resources/ResourceHolder.hpp>
 #include <Thor/Resources/ResourceLoader.hpp>
+#include <Thor/Resources/AsyncResourceLoader.hpp>
+#include <Thor/Resources/AssetPack.hpp>
+#include <Thor/Resources/DecodedImageCache.hpp>
 #include <Thor/Resources/ResourceExceptions.hpp>
 #include <Thor/Resources/SfmlLoaders.hpp>
 
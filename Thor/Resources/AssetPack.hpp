@@ -0,0 +1,263 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2015 Jan Haller
+// 
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+// 
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+// 
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+/// @file
+/// @brief Class thor::AssetPack and pack resource loaders
+
+#ifndef THOR_ASSETPACK_HPP
+#define THOR_ASSETPACK_HPP
+
+#include <Thor/Resources/ResourceLoader.hpp>
+#include <Thor/Resources/AsyncResourceLoader.hpp>
+#include <Thor/Resources/Detail/ResourceLoaderHelpers.hpp>
+#include <Thor/Resources/Detail/MappedFile.hpp>
+
+#include <Aurora/Tools/NonCopyable.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+
+namespace thor
+{
+namespace detail
+{
+
+	// On-disk layout of an asset pack (little endian):
+	//   PackHeader
+	//   PackEntry[entryCount], sorted by name (byte-wise)
+	//   name table, names are not null-terminated
+	//   blobs, each starting at a multiple of the header's alignment
+	struct PackHeader
+	{
+		char				magic[4];
+		std::uint32_t		version;
+		std::uint32_t		entryCount;
+		std::uint32_t		alignment;
+	};
+
+	struct PackEntry
+	{
+		std::uint64_t		offset;
+		std::uint64_t		size;
+		std::uint32_t		nameOffset;
+		std::uint32_t		nameLength;
+	};
+
+	static_assert(sizeof(PackHeader) == 16 && sizeof(PackEntry) == 24, "Asset pack structures must not be padded");
+
+	const char				PackMagic[4] = { 'T', 'P', 'A', 'K' };
+	const std::uint32_t		PackVersion = 1;
+
+} // namespace detail
+
+
+/// @addtogroup Resources
+/// @{
+
+/// @brief Read-only archive of assets, memory-mapped as a whole.
+/// @details An asset pack is a single file containing an index and the raw bytes of many asset files (e.g. PNG images).
+///  Opening a pack maps it into memory and validates the index, without reading the assets. Resources are then loaded
+///  with Resources::fromPack() or Resources::fromImagePack(), which pass pointers into the mapping directly to
+///  loadFromMemory(), so the asset bytes are never copied into intermediate buffers.
+/// @n@n Packs are created offline with the AssetPacker tool. The pack must stay open as long as resources are loaded
+///  from it, and as long as resources that keep referring to their source memory (such as sf::Music) are in use.
+/// @n@n Looking up assets is thread-safe.
+class AssetPack : private aurora::NonCopyable
+{
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Public member functions
+	public:
+		/// @brief Default constructor
+		/// @details Creates a closed pack.
+									AssetPack()
+		: mFile()
+		, mEntries(nullptr)
+		, mEntryCount(0)
+		, mNames(nullptr)
+		{
+		}
+
+		/// @brief Maps the pack file into memory.
+		/// @param filename The name of the pack file.
+		/// @return True if the file could be mapped and is a valid asset pack; otherwise the pack remains closed.
+		bool						open(const std::string& filename)
+		{
+			close();
+			if (!mFile.open(filename) || !validate())
+			{
+				close();
+				return false;
+			}
+
+			return true;
+		}
+
+		/// @brief Unmaps the pack file.
+		/// 
+		void						close()
+		{
+			mFile.close();
+			mEntries = nullptr;
+			mEntryCount = 0;
+			mNames = nullptr;
+		}
+
+		/// @brief Returns whether a pack file is currently mapped.
+		/// 
+		bool						isOpen() const
+		{
+			return mEntries != nullptr;
+		}
+
+		/// @brief Returns the number of assets in the pack.
+		/// 
+		std::size_t					getAssetCount() const
+		{
+			return mEntryCount;
+		}
+
+		/// @brief Looks up an asset by name.
+		/// @param name The name of the asset, as given to the packer (usually its relative path).
+		/// @param size Receives the size of the asset in bytes.
+		/// @return Pointer to the asset's bytes inside the mapping, or nullptr if the pack doesn't contain the asset.
+		const void*					find(const std::string& name, std::size_t& size) const
+		{
+			const detail::PackEntry* end = mEntries + mEntryCount;
+			const detail::PackEntry* found = std::lower_bound(mEntries, end, name,
+				[this] (const detail::PackEntry& entry, const std::string& key) { return compareName(entry, key) < 0; });
+
+			if (found == end || compareName(*found, name) != 0)
+				return nullptr;
+
+			size = static_cast<std::size_t>(found->size);
+			return mFile.getData() + found->offset;
+		}
+
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Private member functions
+	private:
+		// Checks header and index, so that find() can trust them afterwards
+		bool						validate()
+		{
+			const char* data = mFile.getData();
+			std::uint64_t fileSize = mFile.getSize();
+
+			detail::PackHeader header;
+			if (fileSize < sizeof(header))
+				return false;
+
+			std::memcpy(&header, data, sizeof(header));
+			if (std::memcmp(header.magic, detail::PackMagic, sizeof(header.magic)) != 0 || header.version != detail::PackVersion)
+				return false;
+
+			std::uint64_t indexEnd = sizeof(header) + std::uint64_t(header.entryCount) * sizeof(detail::PackEntry);
+			if (indexEnd > fileSize)
+				return false;
+
+			const detail::PackEntry* entries = reinterpret_cast<const detail::PackEntry*>(data + sizeof(header));
+			for (std::uint32_t i = 0; i < header.entryCount; ++i)
+			{
+				const detail::PackEntry& entry = entries[i];
+				if (indexEnd + entry.nameOffset + entry.nameLength > fileSize
+				 || entry.offset > fileSize || entry.size > fileSize - entry.offset)
+					return false;
+			}
+
+			mEntries = entries;
+			mEntryCount = header.entryCount;
+			mNames = data + indexEnd;
+			return true;
+		}
+
+		// Byte-wise comparison of an entry's name with key, like std::string::compare()
+		int							compareName(const detail::PackEntry& entry, const std::string& key) const
+		{
+			std::size_t length = std::min<std::size_t>(entry.nameLength, key.size());
+			int result = std::memcmp(mNames + entry.nameOffset, key.data(), length);
+			if (result != 0)
+				return result;
+
+			return (entry.nameLength < key.size()) ? -1 : (entry.nameLength > key.size()) ? 1 : 0;
+		}
+
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Private variables
+	private:
+		detail::MappedFile			mFile;
+		const detail::PackEntry*	mEntries;
+		std::uint32_t				mEntryCount;
+		const char*					mNames;
+};
+
+namespace Resources
+{
+
+	/// @brief Load the resource from an asset pack.
+	/// @param pack The opened asset pack. Must outlive the loading.
+	/// @param name The name of the asset inside the pack.
+	/// @return Resource loader which is going to invoke <i>loadFromMemory(data, size)</i> with the asset's bytes in the mapping.
+	template <class R>
+	ResourceLoader<R> fromPack(const AssetPack& pack, const std::string& name)
+	{
+		return detail::makeResourceLoader<R>(
+			[&pack, name] (R& resource) -> bool
+			{
+				std::size_t size = 0;
+				const void* data = pack.find(name, size);
+				return data && resource.loadFromMemory(data, size);
+			},
+			detail::Tagger("Pack") << name);
+	}
+
+	/// @brief Load the resource (usually sf::Texture) from an image in an asset pack, decoding the image on a worker thread.
+	/// @param pack The opened asset pack. Must outlive the loading.
+	/// @param name The name of the image inside the pack.
+	/// @return Asynchronous resource loader which decodes the asset's bytes in the mapping into a sf::Image, and then
+	///  invokes <i>loadFromImage(image)</i> on the owning thread.
+	template <class R>
+	AsyncResourceLoader<R> fromImagePack(const AssetPack& pack, const std::string& name)
+	{
+		return detail::makeAsyncImageLoader<R>(
+			[&pack, name] (sf::Image& image) -> bool
+			{
+				std::size_t size = 0;
+				const void* data = pack.find(name, size);
+				return data && image.loadFromMemory(data, size);
+			},
+			detail::Tagger("ImagePack") << name);
+	}
+
+} // namespace Resources
+
+/// @}
+
+} // namespace thor
+
+#endif // THOR_ASSETPACK_HPP
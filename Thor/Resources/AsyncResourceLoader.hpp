@@ -0,0 +1,159 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2015 Jan Haller
+// 
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+// 
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+// 
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+/// @file
+/// @brief Class template thor::AsyncResourceLoader
+
+#ifndef THOR_ASYNCRESOURCELOADER_HPP
+#define THOR_ASYNCRESOURCELOADER_HPP
+
+#include <Thor/Resources/ResourceLoader.hpp>
+#include <Thor/Resources/Detail/ResourceLoaderHelpers.hpp>
+
+#include <SFML/Graphics/Image.hpp>
+
+#include <functional>
+#include <memory>
+#include <string>
+
+
+namespace thor
+{
+
+/// @addtogroup Resources
+/// @{
+
+/// @brief Class storing loading information for resources that are loaded in two stages
+/// @details The first stage (decoding) is thread-safe and runs on a worker thread, for example reading and decompressing
+///  an image file. It returns a ResourceLoader for the second stage (finalization), which runs on the thread that owns
+///  the ResourceHolder, for example uploading the decoded pixels to an OpenGL texture.
+/// @see ResourceHolder::acquireAsync()
+template <class R>
+class AsyncResourceLoader
+{
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Public types
+	public:
+		/// @brief Function type for the decoding stage.
+		/// 
+		typedef std::function< ResourceLoader<R>() > Decoder;
+
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Public member functions
+	public:
+		/// @brief Constructor
+		/// @param decoder Function running the decoding stage and returning the loader for the finalization stage. It is invoked
+		///  on a worker thread, so it shall not access OpenGL or unsynchronized shared state. Decoding failures shall be reported
+		///  through a returned loader that yields nullptr; the function shall not throw any exceptions.
+		/// @param id Identifier which is equal to another identifier if and only if the key refers to the same resource.
+									AsyncResourceLoader(std::function< ResourceLoader<R>() > decoder, std::string id)
+		: mDecoder(std::move(decoder))
+		, mId(std::move(id))
+		{
+		}
+
+		/// @brief Runs the decoding stage.
+		/// @return Loader for the finalization stage.
+		ResourceLoader<R>			decode() const
+		{
+			return mDecoder();
+		}
+
+		/// @brief Returns a string describing the resource loader.
+		/// 
+		std::string					getInfo() const
+		{
+			return mId;
+		}
+
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Private variables
+	private:
+		Decoder						mDecoder;
+		std::string					mId;
+};
+
+namespace detail
+{
+
+	// Finalizes a resource from a decoded image; images themselves are just copied
+	template <class R>
+	bool finalizeFromImage(R& resource, const sf::Image& image)
+	{
+		return resource.loadFromImage(image);
+	}
+
+	inline bool finalizeFromImage(sf::Image& resource, const sf::Image& image)
+	{
+		resource = image;
+		return true;
+	}
+
+	// Creates an asynchronous loader that decodes an sf::Image with
+	//      bool               imageDecoder(sf::Image&)
+	// on a worker thread, and finalizes the resource with loadFromImage() (or a copy, if R is sf::Image).
+	template <class R, typename Fn>
+	AsyncResourceLoader<R> makeAsyncImageLoader(Fn imageDecoder, std::string id)
+	{
+		return AsyncResourceLoader<R>(
+			[=] () -> ResourceLoader<R>
+			{
+				std::shared_ptr<sf::Image> image = std::make_shared<sf::Image>();
+				if (!imageDecoder(*image))
+					image.reset();
+
+				return makeResourceLoader<R>(
+					[image] (R& resource) { return image && finalizeFromImage(resource, *image); },
+					id);
+			},
+			id);
+	}
+
+} // namespace detail
+
+namespace Resources
+{
+
+	/// @brief Load the resource (usually sf::Texture) from an image file, decoding the file on a worker thread.
+	/// @param filename The name of the image file.
+	/// @return Asynchronous resource loader which decodes the file into a sf::Image, and then invokes
+	///  <i>loadFromImage(image)</i> on the owning thread. If @a R is sf::Image, the decoded image is copied instead.
+	template <class R>
+	AsyncResourceLoader<R> fromImageFile(const std::string& filename)
+	{
+		return detail::makeAsyncImageLoader<R>(
+			[=] (sf::Image& image) { return image.loadFromFile(filename); },
+			detail::Tagger("ImageFile") << filename);
+	}
+
+} // namespace Resources
+
+/// @}
+
+} // namespace thor
+
+#endif // THOR_ASYNCRESOURCELOADER_HPP
@@ -0,0 +1,258 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2015 Jan Haller
+// 
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+// 
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+// 
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+/// @file
+/// @brief Class thor::DecodedImageCache and cached image loaders
+
+#ifndef THOR_DECODEDIMAGECACHE_HPP
+#define THOR_DECODEDIMAGECACHE_HPP
+
+#include <Thor/Resources/AsyncResourceLoader.hpp>
+#include <Thor/Resources/AssetPack.hpp>
+#include <Thor/Resources/Detail/ResourceLoaderHelpers.hpp>
+#include <Thor/Resources/Detail/MappedFile.hpp>
+
+#include <SFML/Graphics/Image.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace thor
+{
+namespace detail
+{
+
+	// Layout of a cache file: header followed by width * height RGBA pixels
+	struct DecodedImageHeader
+	{
+		char				magic[4];
+		std::uint32_t		version;
+		std::uint64_t		sourceHash;
+		std::uint32_t		width;
+		std::uint32_t		height;
+	};
+
+	static_assert(sizeof(DecodedImageHeader) == 24, "Decoded image header must not be padded");
+
+	const char				DecodedImageMagic[4] = { 'T', 'R', 'G', 'B' };
+	const std::uint32_t		DecodedImageVersion = 1;
+
+	// 64 bit FNV-1a
+	inline std::uint64_t hashBytes(const void* data, std::size_t size)
+	{
+		const unsigned char* bytes = static_cast<const unsigned char*>(data);
+		std::uint64_t result = 14695981039346656037ull;
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			result ^= bytes[i];
+			result *= 1099511628211ull;
+		}
+		return result;
+	}
+
+} // namespace detail
+
+
+/// @addtogroup Resources
+/// @{
+
+/// @brief On-disk cache of decoded images.
+/// @details Decoding compressed images (e.g. inflating PNG data) is the most expensive part of loading textures. The cache
+///  stores the decoded RGBA pixels of every image in a file of its own, so that subsequent launches only map that file and
+///  copy the pixels. Each cache file records a hash of the compressed source bytes; when the source changes, the hash no
+///  longer matches and the entry is decoded and written again. No manual invalidation is necessary.
+/// @n@n The cache directory must exist. If cache files cannot be written, images are still decoded, just not cached.
+///  Decoding through the cache is thread-safe.
+class DecodedImageCache
+{
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Public member functions
+	public:
+		/// @brief Constructor
+		/// @param directory Existing directory in which the cache files are stored.
+		explicit					DecodedImageCache(std::string directory)
+		: mDirectory(std::move(directory))
+		{
+		}
+
+		/// @brief Decodes an image, using the cached pixels if they are up to date.
+		/// @param data,size The compressed image, as accepted by sf::Image::loadFromMemory().
+		/// @param key Name that identifies the image across launches, usually its file name.
+		/// @param image Receives the decoded image.
+		/// @return True if the image could be decoded.
+		bool						decode(const void* data, std::size_t size, const std::string& key, sf::Image& image) const
+		{
+			std::uint64_t sourceHash = detail::hashBytes(data, size);
+			std::string cacheFile = getCacheFile(key);
+
+			if (loadCached(cacheFile, sourceHash, image))
+				return true;
+
+			if (!image.loadFromMemory(data, size))
+				return false;
+
+			store(cacheFile, sourceHash, image);
+			return true;
+		}
+
+		/// @brief Decodes an image file, using the cached pixels if they are up to date.
+		/// @param filename The name of the image file, which is also used as key.
+		/// @param image Receives the decoded image.
+		/// @return True if the image could be decoded.
+		bool						decodeFile(const std::string& filename, sf::Image& image) const
+		{
+			std::ifstream file(filename, std::ios::binary);
+			if (!file)
+				return false;
+
+			std::vector<char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+			return !bytes.empty() && decode(bytes.data(), bytes.size(), filename, image);
+		}
+
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Private member functions
+	private:
+		// One cache file per key, so that an updated source replaces its stale entry
+		std::string					getCacheFile(const std::string& key) const
+		{
+			std::ostringstream name;
+			name << mDirectory << '/' << std::hex << detail::hashBytes(key.data(), key.size()) << ".rgba";
+			return name.str();
+		}
+
+		// Creates the image from a cache file if it exists and belongs to the current source
+		static bool					loadCached(const std::string& cacheFile, std::uint64_t sourceHash, sf::Image& image)
+		{
+			detail::MappedFile mapped;
+			if (!mapped.open(cacheFile) || mapped.getSize() < sizeof(detail::DecodedImageHeader))
+				return false;
+
+			detail::DecodedImageHeader header;
+			std::memcpy(&header, mapped.getData(), sizeof(header));
+
+			std::uint64_t pixelBytes = std::uint64_t(header.width) * header.height * 4;
+			if (std::memcmp(header.magic, detail::DecodedImageMagic, sizeof(header.magic)) != 0
+			 || header.version != detail::DecodedImageVersion
+			 || header.sourceHash != sourceHash
+			 || header.width == 0 || header.height == 0
+			 || mapped.getSize() != sizeof(header) + pixelBytes)
+				return false;
+
+			// Same as Resources::fromPixels<sf::Image>(), but filling the given image
+			image.create(header.width, header.height, reinterpret_cast<const sf::Uint8*>(mapped.getData() + sizeof(header)));
+			return true;
+		}
+
+		// Writes the decoded image. A temporary file is renamed into place, so that readers never see partial entries.
+		static void					store(const std::string& cacheFile, std::uint64_t sourceHash, const sf::Image& image)
+		{
+			detail::DecodedImageHeader header;
+			std::memcpy(header.magic, detail::DecodedImageMagic, sizeof(header.magic));
+			header.version = detail::DecodedImageVersion;
+			header.sourceHash = sourceHash;
+			header.width = image.getSize().x;
+			header.height = image.getSize().y;
+
+			std::ostringstream tempName;
+			tempName << cacheFile << '.' << std::hash<std::thread::id>()(std::this_thread::get_id()) << ".tmp";
+			std::string tempFile = tempName.str();
+
+			{
+				std::ofstream file(tempFile, std::ios::binary);
+				file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+				file.write(reinterpret_cast<const char*>(image.getPixelsPtr()), std::streamsize(header.width) * header.height * 4);
+				if (!file)
+				{
+					file.close();
+					std::remove(tempFile.c_str());
+					return;
+				}
+			}
+
+			// std::rename() does not replace existing files on every platform
+			std::remove(cacheFile.c_str());
+			if (std::rename(tempFile.c_str(), cacheFile.c_str()) != 0)
+				std::remove(tempFile.c_str());
+		}
+
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Private variables
+	private:
+		std::string					mDirectory;
+};
+
+namespace Resources
+{
+
+	/// @brief Load the resource (usually sf::Texture) from an image file through a decoded image cache.
+	/// @param filename The name of the image file.
+	/// @param cache The cache of decoded images. Must outlive the loading.
+	/// @return Asynchronous resource loader which decodes the file (or reads its cached pixels) into a sf::Image on a worker
+	///  thread, and then invokes <i>loadFromImage(image)</i> on the owning thread.
+	template <class R>
+	AsyncResourceLoader<R> fromImageFile(const std::string& filename, const DecodedImageCache& cache)
+	{
+		return detail::makeAsyncImageLoader<R>(
+			[&cache, filename] (sf::Image& image) { return cache.decodeFile(filename, image); },
+			detail::Tagger("ImageFile") << filename);
+	}
+
+	/// @brief Load the resource (usually sf::Texture) from an image in an asset pack through a decoded image cache.
+	/// @param pack The opened asset pack. Must outlive the loading.
+	/// @param name The name of the image inside the pack.
+	/// @param cache The cache of decoded images. Must outlive the loading.
+	/// @return Asynchronous resource loader which decodes the asset (or reads its cached pixels) into a sf::Image on a worker
+	///  thread, and then invokes <i>loadFromImage(image)</i> on the owning thread.
+	template <class R>
+	AsyncResourceLoader<R> fromImagePack(const AssetPack& pack, const std::string& name, const DecodedImageCache& cache)
+	{
+		return detail::makeAsyncImageLoader<R>(
+			[&pack, &cache, name] (sf::Image& image) -> bool
+			{
+				std::size_t size = 0;
+				const void* data = pack.find(name, size);
+				return data && cache.decode(data, size, name, image);
+			},
+			detail::Tagger("ImagePack") << name);
+	}
+
+} // namespace Resources
+
+/// @}
+
+} // namespace thor
+
+#endif // THOR_DECODEDIMAGECACHE_HPP
@@ -0,0 +1,303 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2015 Jan Haller
+// 
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+// 
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+// 
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef THOR_HASHTABLE_HPP
+#define THOR_HASHTABLE_HPP
+
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+	#include <string_view>
+	#define THOR_HAS_STRING_VIEW
+#endif
+
+
+namespace thor
+{
+namespace detail
+{
+
+	// Transparent string hash: std::string, C strings and std::string_view with equal characters hash equally,
+	// so that lookups do not need to construct a std::string.
+	struct StringHash
+	{
+		std::size_t operator() (const std::string& key) const
+		{
+			return hash(key.data(), key.size());
+		}
+
+		std::size_t operator() (const char* key) const
+		{
+			return hash(key, std::strlen(key));
+		}
+
+	#ifdef THOR_HAS_STRING_VIEW
+		std::size_t operator() (std::string_view key) const
+		{
+			return hash(key.data(), key.size());
+		}
+	#endif
+
+		// FNV-1a
+		static std::size_t hash(const char* data, std::size_t size)
+		{
+			std::size_t result = static_cast<std::size_t>(2166136261u);
+			for (std::size_t i = 0; i < size; ++i)
+			{
+				result ^= static_cast<unsigned char>(data[i]);
+				result *= static_cast<std::size_t>(16777619u);
+			}
+			return result;
+		}
+	};
+
+	// Hash function used for IDs of type I
+	template <typename I>
+	struct HashFor
+	{
+		typedef std::hash<I> Type;
+	};
+
+	template <>
+	struct HashFor<std::string>
+	{
+		typedef StringHash Type;
+	};
+
+	// Open addressing hash table with linear probing and backward shift deletion.
+	// Elements are allocated individually and never move, so iterators (plain pointers to the elements) stay valid until
+	// the element is erased, even when the table grows. This is required by TrackingDeleter, which stores iterators.
+	// Only the subset of the std::map interface used by ResourceHolder is provided; in particular there is no iteration.
+	// Lookup is heterogeneous: find() accepts any type that Hash and Equal accept.
+	template <typename Key, typename Value, typename Hash, typename Equal = std::equal_to<>>
+	class HashTable
+	{
+		public:
+			typedef std::pair<const Key, Value>		value_type;
+			typedef value_type*						iterator;
+			typedef const value_type*				const_iterator;
+
+		private:
+			struct Slot
+			{
+				std::size_t						hash;
+				std::unique_ptr<value_type>		element; // nullptr if the slot is empty
+			};
+
+		public:
+			HashTable()
+			: mSlots()
+			, mSize(0)
+			, mHash()
+			, mEqual()
+			{
+			}
+
+			HashTable(HashTable&& source)
+			: mSlots(std::move(source.mSlots))
+			, mSize(source.mSize)
+			, mHash(std::move(source.mHash))
+			, mEqual(std::move(source.mEqual))
+			{
+				source.mSize = 0;
+			}
+
+			HashTable& operator= (HashTable&& source)
+			{
+				mSlots = std::move(source.mSlots);
+				mSize = source.mSize;
+				mHash = std::move(source.mHash);
+				mEqual = std::move(source.mEqual);
+				source.mSlots.clear();
+				source.mSize = 0;
+				return *this;
+			}
+
+			iterator end()
+			{
+				return nullptr;
+			}
+
+			const_iterator end() const
+			{
+				return nullptr;
+			}
+
+			template <typename K>
+			iterator find(const K& key)
+			{
+				std::size_t slot = findSlot(key, mHash(key));
+				return slot != NotFound ? mSlots[slot].element.get() : nullptr;
+			}
+
+			template <typename K>
+			const_iterator find(const K& key) const
+			{
+				std::size_t slot = findSlot(key, mHash(key));
+				return slot != NotFound ? mSlots[slot].element.get() : nullptr;
+			}
+
+			// Inserts the pair (key, value) unless key is already stored. Returns the element with that key, and whether it was inserted.
+			template <typename Pair>
+			std::pair<iterator, bool> insert(Pair&& pair)
+			{
+				std::size_t hash = mHash(pair.first);
+				std::size_t slot = findSlot(pair.first, hash);
+				if (slot != NotFound)
+					return std::make_pair(mSlots[slot].element.get(), false);
+
+				// Keep the load factor at or below 3/4
+				if (4 * (mSize + 1) > 3 * mSlots.size())
+					rehash(mSlots.empty() ? 16 : 2 * mSlots.size());
+
+				std::unique_ptr<value_type> element(new value_type(std::forward<Pair>(pair)));
+				iterator inserted = element.get();
+				place(hash, std::move(element));
+				++mSize;
+
+				return std::make_pair(inserted, true);
+			}
+
+			void erase(iterator itr)
+			{
+				// Find the slot owning the element by probing from the element's home slot
+				std::size_t mask = mSlots.size() - 1;
+				std::size_t slot = home(mHash(itr->first));
+				while (mSlots[slot].element.get() != itr)
+					slot = (slot + 1) & mask;
+
+				eraseSlot(slot);
+			}
+
+			template <typename K>
+			std::size_t erase(const K& key)
+			{
+				std::size_t slot = findSlot(key, mHash(key));
+				if (slot == NotFound)
+					return 0;
+
+				eraseSlot(slot);
+				return 1;
+			}
+
+			void clear()
+			{
+				mSlots.clear();
+				mSize = 0;
+			}
+
+			std::size_t size() const
+			{
+				return mSize;
+			}
+
+		private:
+			static const std::size_t NotFound = static_cast<std::size_t>(-1);
+
+			// Scrambles the hash, so that hash functions with poor low bits (e.g. identity for integers) spread well
+			std::size_t home(std::size_t hash) const
+			{
+				hash ^= hash >> 16;
+				hash *= static_cast<std::size_t>(0x45d9f3bu);
+				hash ^= hash >> 16;
+				return hash & (mSlots.size() - 1);
+			}
+
+			template <typename K>
+			std::size_t findSlot(const K& key, std::size_t hash) const
+			{
+				if (mSlots.empty())
+					return NotFound;
+
+				std::size_t mask = mSlots.size() - 1;
+				for (std::size_t slot = home(hash); mSlots[slot].element; slot = (slot + 1) & mask)
+				{
+					if (mSlots[slot].hash == hash && mEqual(mSlots[slot].element->first, key))
+						return slot;
+				}
+
+				return NotFound;
+			}
+
+			// Puts an element into the first empty slot of its probe sequence (there must be one)
+			void place(std::size_t hash, std::unique_ptr<value_type> element)
+			{
+				std::size_t mask = mSlots.size() - 1;
+				std::size_t slot = home(hash);
+				while (mSlots[slot].element)
+					slot = (slot + 1) & mask;
+
+				mSlots[slot].hash = hash;
+				mSlots[slot].element = std::move(element);
+			}
+
+			void rehash(std::size_t slotCount)
+			{
+				std::vector<Slot> old(slotCount);
+				old.swap(mSlots);
+
+				for (Slot& slot : old)
+				{
+					if (slot.element)
+						place(slot.hash, std::move(slot.element));
+				}
+			}
+
+			// Empties a slot and moves later elements of the same cluster back, so that no tombstones are needed
+			void eraseSlot(std::size_t hole)
+			{
+				std::size_t mask = mSlots.size() - 1;
+				mSlots[hole].element.reset();
+				--mSize;
+
+				for (std::size_t slot = (hole + 1) & mask; mSlots[slot].element; slot = (slot + 1) & mask)
+				{
+					// An element may only fill the hole if its home slot is not cyclically within (hole, slot]
+					std::size_t ideal = home(mSlots[slot].hash);
+					bool staysBehindHole = (hole <= slot) ? (hole < ideal && ideal <= slot) : (hole < ideal || ideal <= slot);
+					if (staysBehindHole)
+						continue;
+
+					mSlots[hole] = std::move(mSlots[slot]);
+					hole = slot;
+				}
+			}
+
+		private:
+			std::vector<Slot>	mSlots; // size is zero or a power of two
+			std::size_t			mSize;
+			Hash				mHash;
+			Equal				mEqual;
+	};
+
+} // namespace detail
+} // namespace thor
+
+#endif // THOR_HASHTABLE_HPP
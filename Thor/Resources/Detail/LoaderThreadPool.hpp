@@ -0,0 +1,126 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2015 Jan Haller
+// 
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+// 
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+// 
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef THOR_LOADERTHREADPOOL_HPP
+#define THOR_LOADERTHREADPOOL_HPP
+
+#include <Aurora/Tools/NonCopyable.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace thor
+{
+namespace detail
+{
+
+	// Fixed set of worker threads executing tasks in FIFO order.
+	// Used to run the decoding stage of asynchronous resource loaders.
+	class LoaderThreadPool : private aurora::NonCopyable
+	{
+		public:
+			typedef std::function<void()> Task;
+
+		public:
+			explicit LoaderThreadPool(unsigned int threadCount)
+			: mWorkers()
+			, mTasks()
+			, mMutex()
+			, mCondition()
+			, mStopped(false)
+			{
+				for (unsigned int i = 0; i < threadCount; ++i)
+					mWorkers.emplace_back([this] () { run(); });
+			}
+
+			// Finishes the queued tasks, then joins all workers
+			~LoaderThreadPool()
+			{
+				{
+					std::lock_guard<std::mutex> lock(mMutex);
+					mStopped = true;
+				}
+				mCondition.notify_all();
+
+				for (std::thread& worker : mWorkers)
+					worker.join();
+			}
+
+			// Enqueues a task. Tasks shall not throw.
+			void push(Task task)
+			{
+				{
+					std::lock_guard<std::mutex> lock(mMutex);
+					mTasks.push_back(std::move(task));
+				}
+				mCondition.notify_one();
+			}
+
+		private:
+			void run()
+			{
+				for (;;)
+				{
+					Task task;
+					{
+						std::unique_lock<std::mutex> lock(mMutex);
+						mCondition.wait(lock, [this] () { return mStopped || !mTasks.empty(); });
+
+						if (mTasks.empty())
+							return;
+
+						task = std::move(mTasks.front());
+						mTasks.pop_front();
+					}
+
+					task();
+				}
+			}
+
+		private:
+			std::vector<std::thread>	mWorkers;
+			std::deque<Task>			mTasks;
+			std::mutex					mMutex;
+			std::condition_variable		mCondition;
+			bool						mStopped;
+	};
+
+	// Returns the pool shared by all resource holders, created on first use with one worker per hardware thread
+	inline LoaderThreadPool& getLoaderThreadPool()
+	{
+		static LoaderThreadPool pool(std::max(1u, std::thread::hardware_concurrency()));
+		return pool;
+	}
+
+} // namespace detail
+} // namespace thor
+
+#endif // THOR_LOADERTHREADPOOL_HPP
@@ -0,0 +1,142 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2015 Jan Haller
+// 
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+// 
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+// 
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <Thor/Resources/Detail/MappedFile.hpp>
+
+#ifdef _WIN32
+	#ifndef WIN32_LEAN_AND_MEAN
+		#define WIN32_LEAN_AND_MEAN
+	#endif
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#include <windows.h>
+#else
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+
+namespace thor
+{
+namespace detail
+{
+
+	MappedFile::MappedFile()
+	: mData(nullptr)
+	, mSize(0)
+	#ifdef _WIN32
+	, mFile(INVALID_HANDLE_VALUE)
+	, mMapping(nullptr)
+	#endif
+	{
+	}
+
+	MappedFile::~MappedFile()
+	{
+		close();
+	}
+
+	bool MappedFile::open(const std::string& filename)
+	{
+		close();
+
+	#ifdef _WIN32
+		mFile = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (mFile == INVALID_HANDLE_VALUE)
+			return false;
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(mFile, &size) || size.QuadPart == 0)
+			return fail();
+
+		mMapping = CreateFileMappingA(mFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!mMapping)
+			return fail();
+
+		mData = MapViewOfFile(mMapping, FILE_MAP_READ, 0, 0, 0);
+		if (!mData)
+			return fail();
+
+		mSize = static_cast<std::size_t>(size.QuadPart);
+	#else
+		int file = ::open(filename.c_str(), O_RDONLY);
+		if (file < 0)
+			return false;
+
+		struct stat status;
+		if (fstat(file, &status) != 0 || status.st_size == 0)
+		{
+			::close(file);
+			return false;
+		}
+
+		// The mapping stays valid after the descriptor is closed
+		void* data = mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+		::close(file);
+		if (data == MAP_FAILED)
+			return false;
+
+		mData = data;
+		mSize = static_cast<std::size_t>(status.st_size);
+	#endif
+
+		return true;
+	}
+
+	void MappedFile::close()
+	{
+	#ifdef _WIN32
+		fail();
+	#else
+		if (mData)
+			munmap(mData, mSize);
+	#endif
+
+		mData = nullptr;
+		mSize = 0;
+	}
+
+	#ifdef _WIN32
+	bool MappedFile::fail()
+	{
+		if (mData)
+			UnmapViewOfFile(mData);
+		if (mMapping)
+			CloseHandle(mMapping);
+		if (mFile != INVALID_HANDLE_VALUE)
+			CloseHandle(mFile);
+
+		mData = nullptr;
+		mMapping = nullptr;
+		mFile = INVALID_HANDLE_VALUE;
+		return false;
+	}
+	#endif
+
+} // namespace detail
+} // namespace thor
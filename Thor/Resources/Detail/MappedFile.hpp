@@ -0,0 +1,85 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2015 Jan Haller
+// 
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+// 
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+// 
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef THOR_MAPPEDFILE_HPP
+#define THOR_MAPPEDFILE_HPP
+
+#include <Aurora/Tools/NonCopyable.hpp>
+
+#include <string>
+#include <cstddef>
+
+
+namespace thor
+{
+namespace detail
+{
+
+	// Read-only memory mapping of a whole file.
+	// The operating system pages the file in on demand, so opening is cheap and nothing is copied.
+	// The system calls are made in MappedFile.cpp, which must be compiled with the code using this class; this keeps
+	// <windows.h> and its macros out of every file that includes the resource headers.
+	class MappedFile : private aurora::NonCopyable
+	{
+		public:
+			MappedFile();
+
+			~MappedFile();
+
+			// Maps the file, returns false on failure. Empty files cannot be mapped.
+			bool open(const std::string& filename);
+
+			void close();
+
+			const char* getData() const
+			{
+				return static_cast<const char*>(mData);
+			}
+
+			std::size_t getSize() const
+			{
+				return mSize;
+			}
+
+		private:
+		#ifdef _WIN32
+			// Releases whatever has been acquired so far
+			bool fail();
+		#endif
+
+		private:
+			void*			mData;
+			std::size_t		mSize;
+		#ifdef _WIN32
+			// Win32 HANDLEs, stored as void* so that this header does not need <windows.h>
+			void*			mFile;
+			void*			mMapping;
+		#endif
+	};
+
+} // namespace detail
+} // namespace thor
+
+#endif // THOR_MAPPEDFILE_HPP
@@ -26,28 +26,31 @@
 namespace thor
 {
 
-template <typename R, typename I, class O>
-ResourceHolder<R, I, O>::ResourceHolder()
+template <typename R, typename I, class O, class S>
+ResourceHolder<R, I, O, S>::ResourceHolder()
 : mMap()
+, mPendingLoads()
 {
 }
 
-template <typename R, typename I, class O>
-ResourceHolder<R, I, O>::ResourceHolder(ResourceHolder&& source)
+template <typename R, typename I, class O, class S>
+ResourceHolder<R, I, O, S>::ResourceHolder(ResourceHolder&& source)
 : mMap(std::move(source.mMap))
+, mPendingLoads(std::move(source.mPendingLoads))
 {
 }
 
-template <typename R, typename I, class O>
-ResourceHolder<R, I, O>& ResourceHolder<R, I, O>::operator= (ResourceHolder&& source)
+template <typename R, typename I, class O, class S>
+ResourceHolder<R, I, O, S>& ResourceHolder<R, I, O, S>::operator= (ResourceHolder&& source)
 {
 	mMap = std::move(source.mMap);
+	mPendingLoads = std::move(source.mPendingLoads);
 
 	return *this;
 }
 
-template <typename R, typename I, class O>
-typename ResourceHolder<R, I, O>::Resource ResourceHolder<R, I, O>::acquire(const I& id, const ResourceLoader<R>& how, Resources::KnownIdStrategy known)
+template <typename R, typename I, class O, class S>
+typename ResourceHolder<R, I, O, S>::Resource ResourceHolder<R, I, O, S>::acquire(const I& id, const ResourceLoader<R>& how, Resources::KnownIdStrategy known)
 {
 	// ID is new: we always load the resource
 	auto found = mMap.find(id);
@@ -70,8 +73,54 @@ typename ResourceHolder<R, I, O>::Resource ResourceHolder<R, I, O>::acquire(cons
 	}
 }
 
-template <typename R, typename I, class O>
-void ResourceHolder<R, I, O>::release(const I& id)
+template <typename R, typename I, class O, class S>
+std::future<typename ResourceHolder<R, I, O, S>::Resource> ResourceHolder<R, I, O, S>::acquireAsync(const I& id, const AsyncResourceLoader<R>& how, Resources::KnownIdStrategy known)
+{
+	// The task is shared because std::function requires copyable targets
+	auto task = std::make_shared<std::packaged_task<ResourceLoader<R>()>>([how] () { return how.decode(); });
+
+	PendingLoad pending = { id, known, task->get_future(), std::promise<Resource>() };
+
+	std::future<Resource> result = pending.finalized.get_future();
+	mPendingLoads.push_back(std::move(pending));
+
+	detail::getLoaderThreadPool().push([task] () { (*task)(); });
+	return result;
+}
+
+template <typename R, typename I, class O, class S>
+std::size_t ResourceHolder<R, I, O, S>::processAsyncLoads()
+{
+	// Finalize the decoded loads and compact the others to the front
+	std::size_t remaining = 0;
+	for (std::size_t i = 0; i < mPendingLoads.size(); ++i)
+	{
+		PendingLoad& pending = mPendingLoads[i];
+		if (pending.decoded.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+			finalize(pending);
+		else if (i != remaining++)
+			mPendingLoads[remaining - 1] = std::move(pending);
+	}
+
+	mPendingLoads.erase(mPendingLoads.begin() + remaining, mPendingLoads.end());
+	return remaining;
+}
+
+template <typename R, typename I, class O, class S>
+void ResourceHolder<R, I, O, S>::finishAsyncLoads()
+{
+	// Decoding runs in parallel, so waiting in request order costs no more than the slowest load
+	for (PendingLoad& pending : mPendingLoads)
+	{
+		pending.decoded.wait();
+		finalize(pending);
+	}
+
+	mPendingLoads.clear();
+}
+
+template <typename R, typename I, class O, class S>
+void ResourceHolder<R, I, O, S>::release(const I& id)
 {
 	auto found = mMap.find(id);
 	if (found == mMap.end())
@@ -80,8 +129,8 @@ void ResourceHolder<R, I, O>::release(const I& id)
 	mMap.erase(found);
 }
 
-template <typename R, typename I, class O>
-typename ResourceHolder<R, I, O>::Resource ResourceHolder<R, I, O>::operator[] (const I& id)
+template <typename R, typename I, class O, class S>
+typename ResourceHolder<R, I, O, S>::Resource ResourceHolder<R, I, O, S>::operator[] (const I& id)
 {
 	auto found = mMap.find(id);
 	if (found == mMap.end())
@@ -90,8 +139,8 @@ typename ResourceHolder<R, I, O>::Resource ResourceHolder<R, I, O>::operator[] (
 	return Om::makeReturned(found->second);
 }
 
-template <typename R, typename I, class O>
-typename ResourceHolder<R, I, O>::ConstResource ResourceHolder<R, I, O>::operator[] (const I& id) const
+template <typename R, typename I, class O, class S>
+typename ResourceHolder<R, I, O, S>::ConstResource ResourceHolder<R, I, O, S>::operator[] (const I& id) const
 {
 	auto found = mMap.find(id);
 	if (found == mMap.end())
@@ -100,8 +149,30 @@ typename ResourceHolder<R, I, O>::ConstResource ResourceHolder<R, I, O>::operato
 	return Om::makeReturned(found->second);
 }
 
-template <typename R, typename I, class O>
-typename ResourceHolder<R, I, O>::Resource ResourceHolder<R, I, O>::load(const I& id, const ResourceLoader<R>& what)
+template <typename R, typename I, class O, class S>
+template <typename K>
+typename ResourceHolder<R, I, O, S>::Resource ResourceHolder<R, I, O, S>::operator[] (const K& key)
+{
+	auto found = mMap.find(key);
+	if (found == mMap.end())
+		throw ResourceAccessException("Failed to access resource, ID not currently stored in ResourceHolder");
+
+	return Om::makeReturned(found->second);
+}
+
+template <typename R, typename I, class O, class S>
+template <typename K>
+typename ResourceHolder<R, I, O, S>::ConstResource ResourceHolder<R, I, O, S>::operator[] (const K& key) const
+{
+	auto found = mMap.find(key);
+	if (found == mMap.end())
+		throw ResourceAccessException("Failed to access resource, ID not currently stored in ResourceHolder");
+
+	return Om::makeReturned(found->second);
+}
+
+template <typename R, typename I, class O, class S>
+typename ResourceHolder<R, I, O, S>::Resource ResourceHolder<R, I, O, S>::load(const I& id, const ResourceLoader<R>& what)
 {
 	assert(mMap.find(id) == mMap.end());
 
@@ -130,4 +201,17 @@ typename ResourceHolder<R, I, O>::Resource ResourceHolder<R, I, O>::load(const I
 	return returned;
 }
 
+template <typename R, typename I, class O, class S>
+void ResourceHolder<R, I, O, S>::finalize(PendingLoad& pending)
+{
+	try
+	{
+		pending.finalized.set_value(acquire(pending.id, pending.decoded.get(), pending.known));
+	}
+	catch (...)
+	{
+		pending.finalized.set_exception(std::current_exception());
+	}
+}
+
 } // namespace thor
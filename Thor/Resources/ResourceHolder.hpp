@@ -31,13 +31,18 @@
 
 #include <Thor/Resources/KnownIdStrategy.hpp>
 #include <Thor/Resources/OwnershipModels.hpp>
+#include <Thor/Resources/StorageModels.hpp>
 #include <Thor/Resources/ResourceExceptions.hpp>
 #include <Thor/Resources/ResourceLoader.hpp>
+#include <Thor/Resources/AsyncResourceLoader.hpp>
+#include <Thor/Resources/Detail/LoaderThreadPool.hpp>
 
 #include <Aurora/Tools/NonCopyable.hpp>
 
 #include <memory>
-#include <map>
+#include <vector>
+#include <future>
+#include <chrono>
 
 
 namespace thor
@@ -56,7 +61,9 @@ namespace thor
 ///   let ResourceLoader::getInfo() generate them automatically -- in this case @a I would be std::string.
 /// @tparam O Ownership model. Determines who owns the resources and is responsible of their lifetime. Possible types:
 ///  Resources::CentralOwner (default), Resources::RefCounted.
-template <typename R, typename I, class O = Resources::CentralOwner>
+/// @tparam S Storage model. Determines the container in which resources are looked up. Possible types:
+///  Resources::OrderedStorage (default), Resources::HashedStorage.
+template <typename R, typename I, class O = Resources::CentralOwner, class S = Resources::OrderedStorage>
 class ResourceHolder : private aurora::NonCopyable
 {
 	// ---------------------------------------------------------------------------------------------------------------------------
@@ -65,6 +72,9 @@ class ResourceHolder : private aurora::NonCopyable
 		// Abbreviate class containing ownership policy types and functions
 		typedef typename detail::OwnershipModel<O, R>	Om;
 
+		// Container type storing the resources, depends on storage policy
+		typedef typename detail::StorageModel<S, I, typename Om::Stored>::Map	Map;
+
 
 	// ---------------------------------------------------------------------------------------------------------------------------
 	// Public types
@@ -108,6 +118,26 @@ class ResourceHolder : private aurora::NonCopyable
 		/// @throw ResourceAccessException if a resource associated with @a id is already known and @a known is AssumeNew.
 		Resource					acquire(const I& id, const ResourceLoader<R>& how, Resources::KnownIdStrategy known = Resources::AssumeNew);
 
+		/// @brief Starts loading a new resource on a worker thread, identified as @a id.
+		/// @details The decoding stage of @a how runs on a shared pool of worker threads, so that several resources can be
+		///  decoded in parallel. The finalization stage runs on the calling thread inside processAsyncLoads() or
+		///  finishAsyncLoads(), where the resource is stored as if acquire() had been called with @a known.
+		/// @param id Value identifying the resource.
+		/// @param how Asynchronous resource loader. Determines how the resource is decoded and finalized.
+		/// @param known Determines what happens if @a id is already known when the resource is finalized.
+		/// @return Future that becomes ready once the resource has been finalized. Its get() rethrows the exceptions that
+		///  acquire() would throw. Do not wait on it before finalizing, use finishAsyncLoads() instead.
+		std::future<Resource>		acquireAsync(const I& id, const AsyncResourceLoader<R>& how, Resources::KnownIdStrategy known = Resources::AssumeNew);
+
+		/// @brief Finalizes the asynchronous loads whose decoding stage has completed, without blocking.
+		/// @details Call this regularly (e.g. once per frame) from the thread that called acquireAsync().
+		/// @return Number of asynchronous loads that are still pending.
+		std::size_t					processAsyncLoads();
+
+		/// @brief Waits until all asynchronous loads are decoded, and finalizes them.
+		/// @details Call this from the thread that called acquireAsync().
+		void						finishAsyncLoads();
+
 		/// @brief Unloads the resource currently identified as @a id.
 		/// @details The resource is removed from this resource holder. Depending on the ownership policy,
 		///  it may either be released immediately or live until it is no longer referenced. In any case,
@@ -130,18 +160,47 @@ class ResourceHolder : private aurora::NonCopyable
 		/// @throw ResourceAccessException If @a id doesn't refer to a currently stored resource.
 		ConstResource				operator[] (const I& id) const;
 
+		/// @brief Accesses a resource using a key equivalent to an identifier.
+		/// @details Allows lookup without constructing an ID, for example with a string literal or std::string_view when
+		///  @a I is std::string.
+		/// @param key Value that compares (OrderedStorage) or hashes and compares (HashedStorage) equal to the resource's ID.
+		/// @return Handle to that resource.
+		/// @throw ResourceAccessException If @a key doesn't refer to a currently stored resource.
+		template <typename K>
+		Resource					operator[] (const K& key);
+
+		/// @brief Accesses a resource using a key equivalent to an identifier (const overload).
+		/// @param key Value that compares (OrderedStorage) or hashes and compares (HashedStorage) equal to the resource's ID.
+		/// @return Handle to that resource, which does not allow modification of the resource.
+		/// @throw ResourceAccessException If @a key doesn't refer to a currently stored resource.
+		template <typename K>
+		ConstResource				operator[] (const K& key) const;
+
 	
 	// ---------------------------------------------------------------------------------------------------------------------------
 	// Private member functions
 	private:
 		// Load resource (must be new)
 		Resource					load(const I& id, const ResourceLoader<R>& how);
+
+		// Asynchronous load whose finalization stage has not run yet
+		struct PendingLoad
+		{
+			I										id;
+			Resources::KnownIdStrategy				known;
+			std::future<ResourceLoader<R>>			decoded;
+			std::promise<Resource>					finalized;
+		};
+
+		// Runs the finalization stage of a decoded load and fulfills its promise
+		void						finalize(PendingLoad& pending);
 	
 
 	// ---------------------------------------------------------------------------------------------------------------------------
 	// Private variables
 	private:
-		std::map<I, typename Om::Stored>	mMap;
+		Map									mMap;
+		std::vector<PendingLoad>			mPendingLoads;
 };
 
 /// @}
@@ -0,0 +1,91 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2015 Jan Haller
+// 
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+// 
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+// 
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+/// @file
+/// @brief Storage models for thor::ResourceHolder
+
+#ifndef THOR_STORAGEMODELS_HPP
+#define THOR_STORAGEMODELS_HPP
+
+#include <Thor/Resources/Detail/HashTable.hpp>
+
+#include <functional>
+#include <map>
+
+
+namespace thor
+{
+
+/// @addtogroup Resources
+/// @{
+
+namespace Resources
+{
+
+	/// @brief Ordered storage policy
+	/// @details Resources are stored in a std::map. IDs must be comparable with operator<.
+	/// @n@n This is the default storage policy.
+	struct OrderedStorage {};
+
+	/// @brief Hashed storage policy
+	/// @details Resources are stored in an open addressing hash table, so that acquiring and accessing a resource costs
+	///  one hash and usually a single ID comparison, instead of a tree walk with a comparison at every level. Prefer this
+	///  policy for holders with many resources, especially with std::string IDs. IDs must be hashable with std::hash;
+	///  std::string IDs use a hash that also accepts C strings and std::string_view, so lookups with them do not create
+	///  temporary strings.
+	struct HashedStorage {};
+
+} // namespace Resources
+
+/// @}
+
+// ---------------------------------------------------------------------------------------------------------------------------
+
+
+namespace detail
+{
+
+	// Class to dispatch between storage models, using partial template specialization
+	template <typename Model, typename I, typename Stored>
+	struct StorageModel;
+
+	// Specialization for ordered storage. The transparent comparator allows lookup with types comparable to I.
+	template <typename I, typename Stored>
+	struct StorageModel<Resources::OrderedStorage, I, Stored>
+	{
+		typedef std::map<I, Stored, std::less<>>								Map;
+	};
+
+	// Specialization for hashed storage
+	template <typename I, typename Stored>
+	struct StorageModel<Resources::HashedStorage, I, Stored>
+	{
+		typedef HashTable<I, Stored, typename HashFor<I>::Type, std::equal_to<>>	Map;
+	};
+
+} // namespace detail
+} // namespace thor
+
+#endif // THOR_STORAGEMODELS_HPP
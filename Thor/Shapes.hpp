@@ -30,6 +30,7 @@
 #define THOR_MODULE_SHAPES_HPP
 
 #include <Thor/Shapes/Arrow.hpp>
+#include <Thor/Shapes/ArrowBatch.hpp>
 #include <Thor/Shapes/ConcaveShape.hpp>
 #include <Thor/Shapes/Shapes.hpp>
 
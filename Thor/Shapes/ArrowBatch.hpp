@@ -0,0 +1,116 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2015 Jan Haller
+// 
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+// 
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+// 
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+/// @file
+/// @brief Class thor::ArrowBatch
+
+#ifndef THOR_ARROWBATCH_HPP
+#define THOR_ARROWBATCH_HPP
+
+#include <Thor/Config.hpp>
+#include <Thor/Shapes/Arrow.hpp>
+#include <Thor/Vectors/VectorAlgebra2D.hpp>
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+
+namespace thor
+{
+
+/// @addtogroup Shapes
+/// @{
+
+/// @brief Draws many arrows at once
+/// @details Every thor::Arrow keeps two shapes with their own vertex arrays and is drawn with separate draw calls. This class
+///  instead writes the geometry of all added arrows into a single vertex array of triangles, which is drawn with one call.
+///  @n All arrows share a unit line, triangle and circle mesh; adding an arrow only transforms these few vertices to the arrow's
+///  position, direction and thickness. The geometry is the same as the one of thor::Arrow, including the circle for zero vectors.
+///  The vertices are kept until clear() is called, so the batch can either be filled once or every frame.
+class ArrowBatch : public sf::Drawable
+{
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Public member functions
+	public:
+		/// @brief Default constructor
+		/// @details Creates an empty batch.
+									ArrowBatch();
+
+		/// @brief Adds the geometry of an existing arrow, including its transform.
+		///
+		void						addArrow(const Arrow& arrow);
+
+		/// @brief Adds an arrow without creating a thor::Arrow object.
+		/// @param position Starting point of the arrow.
+		/// @param direction Direction of the arrow (the vector you want to represent).
+		/// @param color The line and triangle color.
+		/// @param thickness The line thickness.
+		/// @param style Whether the arrow has a triangle at its end point.
+		void						addArrow(sf::Vector2f position, sf::Vector2f direction, const sf::Color& color = sf::Color::White,
+										float thickness = 3.f, Arrow::Style style = Arrow::Forward);
+
+		/// @brief Removes all arrows.
+		/// @details The memory of the vertex array is kept for the next arrows.
+		void						clear();
+
+		/// @brief Returns the number of arrows added since the last clear().
+		///
+		std::size_t					getArrowCount() const;
+
+		/// @brief Returns the vertices of all arrows, as sf::Triangles.
+		/// @details This allows to put the arrows into another vertex buffer instead of drawing the batch itself.
+		const sf::VertexArray&		getVertices() const;
+
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Private member functions
+	private:
+		void						appendArrow(const sf::Transform& transform, sf::Vector2f position, sf::Vector2f direction,
+										const sf::Color& color, float thickness, Arrow::Style style);
+		void						appendMesh(const sf::Transform& meshTransform, const sf::Vector2f* mesh, std::size_t vertexCount,
+										const sf::Color& color);
+		virtual void				draw(sf::RenderTarget& target, sf::RenderStates states) const;
+
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Private variables
+	private:
+		sf::VertexArray				mVertices;
+		std::size_t					mArrowCount;
+};
+
+/// @}
+
+} // namespace thor
+
+#include <Thor/Shapes/Detail/ArrowBatch.inl>
+#endif // THOR_ARROWBATCH_HPP
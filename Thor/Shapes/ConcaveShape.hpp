@@ -30,13 +30,25 @@
 #define THOR_CONCAVESHAPE_HPP
 
 #include <Thor/Config.hpp>
+#include <Thor/Math/MemoryArena.hpp>
+#include <Thor/Math/Predicates.hpp>
+#include <Thor/Math/Triangulation.hpp>
+#include <Thor/Vectors/VectorAlgebra2D.hpp>
+
+#include <Aurora/Tools/ForEach.hpp>
 
 #include <SFML/Graphics/Color.hpp>
-#include <SFML/Graphics/ConvexShape.hpp>
 #include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Shape.hpp>
 #include <SFML/Graphics/Transformable.hpp>
 #include <SFML/Graphics/VertexArray.hpp>
 
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iterator>
+#include <utility>
 #include <vector>
 
 
@@ -49,7 +61,10 @@ namespace thor
 /// @brief Concave shape class
 /// @details This class has an interface and functionality similar to sf::ConvexShape, but is additionally able to work
 ///  with shapes that are concave. It inherits the sf::Drawable and sf::Transformable classes.
-class THOR_API ConcaveShape : public sf::Drawable, public sf::Transformable
+/// @n When only some points are moved with setPoint(), the next draw re-triangulates just the triangles adjacent to them,
+///  which keeps animated outlines cheap. If the moved points change the polygon too much for that, or more than a quarter of
+///  the points moved, the whole polygon is triangulated again.
+class ConcaveShape : public sf::Drawable, public sf::Transformable
 {
 	// ---------------------------------------------------------------------------------------------------------------------------
 	// Public member functions
@@ -71,6 +86,7 @@ class THOR_API ConcaveShape : public sf::Drawable, public sf::Transformable
 		std::size_t					getPointCount() const;
 
 		/// @brief Sets the position of a point.
+		/// @details Only the triangles adjacent to the moved point are re-triangulated on the next draw.
 		/// @param index Which point? Must be in [0, getPointCount()[
 		/// @param position New point position in local coordinates.
 		void						setPoint(std::size_t index, sf::Vector2f position);
@@ -103,6 +119,11 @@ class THOR_API ConcaveShape : public sf::Drawable, public sf::Transformable
 		///
 		float						getOutlineThickness() const;
 
+		/// @brief Sets the arena from which temporary memory for the decomposition is taken.
+		/// @details By default (and if @a arena is a null pointer), the heap is used. The shape does not reset the arena, so it
+		///  should be reset regularly, e.g. once per frame. The arena must stay alive as long as the shape is drawn with it.
+		void						setMemoryArena(MemoryArena* arena);
+
 		/// @brief Return untransformed bounding rectangle.
 		///
 		sf::FloatRect				getLocalBounds() const;
@@ -114,12 +135,6 @@ class THOR_API ConcaveShape : public sf::Drawable, public sf::Transformable
 		sf::FloatRect				getGlobalBounds() const;
 
 
-	// ---------------------------------------------------------------------------------------------------------------------------
-	// Private types
-	private:
-		struct TriangleGenerator;
-
-
 	// ---------------------------------------------------------------------------------------------------------------------------
 	// Private member functions
 	private:
@@ -129,6 +144,17 @@ class THOR_API ConcaveShape : public sf::Drawable, public sf::Transformable
 		// Computes how the shape can be split up into convex triangles.
 		void						ensureDecomposed() const;
 
+		// Triangulates the whole polygon.
+		void						decompose() const;
+
+		// Re-triangulates the triangles adjacent to moved points, or a slightly larger region around them if necessary.
+		// Returns false if the moved points require the whole polygon to be triangulated again.
+		bool						redecomposeMovedPoints() const;
+
+		// Re-triangulates the triangles with a corner in region. Returns false and extends region by the other corners of
+		// these triangles if the region, with the moved points, overlaps itself.
+		bool						redecomposeRegion(detail::ArenaVector<bool>& region) const;
+
 		// Forms the outline out of the given edges.
 		void						ensureOutlineUpdated() const;
 
@@ -141,9 +167,12 @@ class THOR_API ConcaveShape : public sf::Drawable, public sf::Transformable
 		sf::Color								mOutlineColor;
 		float									mOutlineThickness;
 
+		mutable std::vector<std::uint32_t>		mTriangles;
+		mutable std::vector<std::uint32_t>		mMovedPoints;
 		mutable sf::VertexArray					mTriangleVertices;
-		mutable std::vector<sf::ConvexShape>	mOutlineShapes;
+		mutable sf::VertexArray					mOutlineVertices;
 		mutable sf::FloatRect					mLocalBounds;
+		MemoryArena*							mArena;
 		mutable bool							mNeedsDecomposition;
 		mutable bool							mNeedsOutlineUpdate;
 };
@@ -152,4 +181,5 @@ class THOR_API ConcaveShape : public sf::Drawable, public sf::Transformable
 
 } // namespace thor
 
+#include <Thor/Shapes/Detail/ConcaveShape.inl>
 #endif // THOR_CONCAVESHAPE_HPP
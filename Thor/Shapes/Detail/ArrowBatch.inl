@@ -0,0 +1,177 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2015 Jan Haller
+// 
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+// 
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+// 
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+namespace thor
+{
+namespace detail
+{
+
+	// Unit meshes shared by all arrows, as triangles. The x axis points along the arrow, the y axis across it.
+	const std::size_t arrowCircleSegments = 12;
+
+	inline const sf::Vector2f* arrowLineMesh()
+	{
+		// Square [0,1] x [-0.5,0.5], scaled to line length and thickness
+		static const sf::Vector2f mesh[6] =
+		{
+			sf::Vector2f(0.f, 0.5f), sf::Vector2f(1.f, 0.5f), sf::Vector2f(1.f, -0.5f),
+			sf::Vector2f(0.f, 0.5f), sf::Vector2f(1.f, -0.5f), sf::Vector2f(0.f, -0.5f),
+		};
+		return mesh;
+	}
+
+	inline const sf::Vector2f* arrowTriangleMesh()
+	{
+		// Scaled to triangle height and line thickness, so the base is four times as wide as the line
+		static const sf::Vector2f mesh[3] =
+		{
+			sf::Vector2f(0.f, 2.f), sf::Vector2f(1.f, 0.f), sf::Vector2f(0.f, -2.f),
+		};
+		return mesh;
+	}
+
+	inline const sf::Vector2f* arrowCircleMesh()
+	{
+		// Triangle fan of a unit circle, scaled to the line thickness
+		struct CircleMesh
+		{
+			CircleMesh()
+			{
+				sf::Vector2f corners[arrowCircleSegments];
+				for (std::size_t i = 0; i < arrowCircleSegments; ++i)
+				{
+					float angle = 2.f * 3.14159265f * i / arrowCircleSegments;
+					corners[i] = sf::Vector2f(std::cos(angle), std::sin(angle));
+				}
+
+				for (std::size_t i = 2; i < arrowCircleSegments; ++i)
+				{
+					vertices[3 * (i-2) + 0] = corners[0];
+					vertices[3 * (i-2) + 1] = corners[i-1];
+					vertices[3 * (i-2) + 2] = corners[i];
+				}
+			}
+
+			sf::Vector2f vertices[3 * (arrowCircleSegments - 2)];
+		};
+
+		static const CircleMesh mesh;
+		return mesh.vertices;
+	}
+
+	// Affine transform that maps the unit x axis to xAxis, the unit y axis to yAxis and the origin to origin
+	inline sf::Transform meshTransform(sf::Vector2f origin, sf::Vector2f xAxis, sf::Vector2f yAxis)
+	{
+		return sf::Transform(
+			xAxis.x, yAxis.x, origin.x,
+			xAxis.y, yAxis.y, origin.y,
+			0.f,     0.f,     1.f);
+	}
+
+} // namespace detail
+
+// ---------------------------------------------------------------------------------------------------------------------------
+
+
+inline ArrowBatch::ArrowBatch()
+: mVertices(sf::Triangles)
+, mArrowCount(0)
+{
+}
+
+inline void ArrowBatch::addArrow(const Arrow& arrow)
+{
+	appendArrow(arrow.getTransform(), sf::Vector2f(), arrow.getDirection(), arrow.getColor(), arrow.getThickness(), arrow.getStyle());
+}
+
+inline void ArrowBatch::addArrow(sf::Vector2f position, sf::Vector2f direction, const sf::Color& color, float thickness, Arrow::Style style)
+{
+	appendArrow(sf::Transform::Identity, position, direction, color, thickness, style);
+}
+
+inline void ArrowBatch::clear()
+{
+	mVertices.clear();
+	mArrowCount = 0;
+}
+
+inline std::size_t ArrowBatch::getArrowCount() const
+{
+	return mArrowCount;
+}
+
+inline const sf::VertexArray& ArrowBatch::getVertices() const
+{
+	return mVertices;
+}
+
+inline void ArrowBatch::appendArrow(const sf::Transform& transform, sf::Vector2f position, sf::Vector2f direction,
+	const sf::Color& color, float thickness, Arrow::Style style)
+{
+	++mArrowCount;
+	const float arrowLength = length(direction);
+
+	// Zero vectors are represented by a circle around the position
+	if (arrowLength <= Arrow::getZeroVectorTolerance())
+	{
+		appendMesh(transform * detail::meshTransform(position, sf::Vector2f(thickness, 0.f), sf::Vector2f(0.f, thickness)),
+			detail::arrowCircleMesh(), 3 * (detail::arrowCircleSegments - 2), color);
+		return;
+	}
+
+	// The line ends where the triangle starts; the triangle is at most four times as high as the line is thick
+	const sf::Vector2f unit = direction / arrowLength;
+	const sf::Vector2f across = perpendicularVector(unit) * thickness;
+	const float triangleHeight = (style == Arrow::Forward) ? std::min(4.f * thickness, arrowLength) : 0.f;
+	const float lineLength = arrowLength - triangleHeight;
+
+	if (lineLength > 0.f)
+		appendMesh(transform * detail::meshTransform(position, unit * lineLength, across), detail::arrowLineMesh(), 6, color);
+
+	if (triangleHeight > 0.f)
+		appendMesh(transform * detail::meshTransform(position + unit * lineLength, unit * triangleHeight, across),
+			detail::arrowTriangleMesh(), 3, color);
+}
+
+inline void ArrowBatch::appendMesh(const sf::Transform& meshTransform, const sf::Vector2f* mesh, std::size_t vertexCount,
+	const sf::Color& color)
+{
+	const std::size_t first = mVertices.getVertexCount();
+	mVertices.resize(first + vertexCount);
+
+	for (std::size_t i = 0; i < vertexCount; ++i)
+	{
+		sf::Vertex& vertex = mVertices[first + i];
+		vertex.position = meshTransform.transformPoint(mesh[i]);
+		vertex.color = color;
+	}
+}
+
+inline void ArrowBatch::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+	target.draw(mVertices, states);
+}
+
+} // namespace thor
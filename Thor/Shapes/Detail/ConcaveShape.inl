@@ -0,0 +1,514 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2015 Jan Haller
+// 
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+// 
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+// 
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+namespace thor
+{
+namespace detail
+{
+
+	// Returns true if the closed segments [a,b] and [c,d] have a point in common
+	inline bool segmentsTouch(sf::Vector2f a, sf::Vector2f b, sf::Vector2f c, sf::Vector2f d)
+	{
+		double abc = orientation(a, b, c);
+		double abd = orientation(a, b, d);
+		double cda = orientation(c, d, a);
+		double cdb = orientation(c, d, b);
+
+		if (((abc > 0 && abd < 0) || (abc < 0 && abd > 0)) && ((cda > 0 && cdb < 0) || (cda < 0 && cdb > 0)))
+			return true;
+
+		// Collinear cases: an end point lies on the other segment
+		auto onSegment = [] (sf::Vector2f p, sf::Vector2f q, sf::Vector2f r)
+		{
+			return std::min(p.x, q.x) <= r.x && r.x <= std::max(p.x, q.x)
+				&& std::min(p.y, q.y) <= r.y && r.y <= std::max(p.y, q.y);
+		};
+
+		return (abc == 0 && onSegment(a, b, c))
+			|| (abd == 0 && onSegment(a, b, d))
+			|| (cda == 0 && onSegment(c, d, a))
+			|| (cdb == 0 && onSegment(c, d, b));
+	}
+
+	// Returns true if the closed polygon doesn't touch itself, except for consecutive edges at their common point
+	inline bool isSimplePolygon(const ArenaVector<sf::Vector2f>& polygon)
+	{
+		const std::size_t size = polygon.size();
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			sf::Vector2f a = polygon[i];
+			sf::Vector2f b = polygon[(i+1) % size];
+			sf::Vector2f c = polygon[(i+2) % size];
+
+			// Consecutive edges may only share their common point, not fold back onto each other
+			if (orientation(a, b, c) == 0 && dotProduct(a - b, c - b) > 0.f)
+				return false;
+
+			// Compare with all later edges that are not adjacent
+			for (std::size_t j = i + 2; j < size; ++j)
+			{
+				if (i == 0 && j == size - 1)
+					continue;
+
+				if (segmentsTouch(a, b, polygon[j], polygon[(j+1) % size]))
+					return false;
+			}
+		}
+
+		return true;
+	}
+
+	// Returns true if the simple polygon is clockwise. The orientation at the lowest-leftmost point is that of the whole
+	// polygon; it cannot be zero there, since that point would have to lie between its neighbors.
+	inline bool isClockwisePolygon(const ArenaVector<sf::Vector2f>& polygon)
+	{
+		const std::size_t size = polygon.size();
+		std::size_t lowest = 0;
+		for (std::size_t i = 1; i < size; ++i)
+		{
+			if (polygon[i].x < polygon[lowest].x || (polygon[i].x == polygon[lowest].x && polygon[i].y < polygon[lowest].y))
+				lowest = i;
+		}
+
+		return orientation(polygon[(lowest + size - 1) % size], polygon[lowest], polygon[(lowest + 1) % size]) < 0;
+	}
+
+	// Returns the unit normal of the edge from -> to, or fallback if the edge has zero length
+	inline sf::Vector2f outlineNormal(sf::Vector2f from, sf::Vector2f to, sf::Vector2f fallback)
+	{
+		if (from == to)
+			return fallback;
+
+		return unitVector(perpendicularVector(to - from));
+	}
+
+} // namespace detail
+
+// ---------------------------------------------------------------------------------------------------------------------------
+
+
+inline ConcaveShape::ConcaveShape()
+: sf::Drawable()
+, sf::Transformable()
+, mPoints()
+, mFillColor()
+, mOutlineColor()
+, mOutlineThickness(0.f)
+, mTriangles()
+, mMovedPoints()
+, mTriangleVertices(sf::Triangles)
+, mOutlineVertices(sf::TriangleStrip)
+, mLocalBounds()
+, mArena(nullptr)
+, mNeedsDecomposition(false)
+, mNeedsOutlineUpdate(false)
+{
+}
+
+inline ConcaveShape::ConcaveShape(const sf::Shape& shape)
+: sf::Drawable()
+, sf::Transformable(shape)
+, mPoints()
+, mFillColor(shape.getFillColor())
+, mOutlineColor(shape.getOutlineColor())
+, mOutlineThickness(shape.getOutlineThickness())
+, mTriangles()
+, mMovedPoints()
+, mTriangleVertices(sf::Triangles)
+, mOutlineVertices(sf::TriangleStrip)
+, mLocalBounds()
+, mArena(nullptr)
+, mNeedsDecomposition(false)
+, mNeedsOutlineUpdate(false)
+{
+	const std::size_t size = shape.getPointCount();
+
+	setPointCount(size);
+	for (std::size_t i = 0; i < size; ++i)
+		setPoint(i, shape.getPoint(i));
+}
+
+inline void ConcaveShape::setPointCount(std::size_t count)
+{
+	mPoints.resize(count);
+
+	// The triangles may refer to removed points, so the next decomposition starts from scratch
+	mTriangles.clear();
+	mMovedPoints.clear();
+
+	mNeedsDecomposition = true;
+	mNeedsOutlineUpdate = true;
+}
+
+inline std::size_t ConcaveShape::getPointCount() const
+{
+	return mPoints.size();
+}
+
+inline void ConcaveShape::setPoint(std::size_t index, sf::Vector2f position)
+{
+	assert(index < mPoints.size());
+
+	if (mPoints[index] == position)
+		return;
+
+	mPoints[index] = position;
+
+	// Remember the point for incremental decomposition; past a certain number, everything is triangulated again anyway
+	if (!mTriangles.empty())
+	{
+		if (mMovedPoints.size() < mPoints.size())
+			mMovedPoints.push_back(static_cast<std::uint32_t>(index));
+		else
+		{
+			mTriangles.clear();
+			mMovedPoints.clear();
+		}
+	}
+
+	mNeedsDecomposition = true;
+	mNeedsOutlineUpdate = true;
+}
+
+inline sf::Vector2f ConcaveShape::getPoint(std::size_t index) const
+{
+	assert(index < mPoints.size());
+	return mPoints[index];
+}
+
+inline void ConcaveShape::setFillColor(const sf::Color& fillColor)
+{
+	mFillColor = fillColor;
+
+	// No new decomposition needed, just recolor the vertices
+	for (std::size_t i = 0; i < mTriangleVertices.getVertexCount(); ++i)
+		mTriangleVertices[i].color = fillColor;
+}
+
+inline void ConcaveShape::setOutlineColor(const sf::Color& outlineColor)
+{
+	mOutlineColor = outlineColor;
+
+	for (std::size_t i = 0; i < mOutlineVertices.getVertexCount(); ++i)
+		mOutlineVertices[i].color = outlineColor;
+}
+
+inline sf::Color ConcaveShape::getFillColor() const
+{
+	return mFillColor;
+}
+
+inline sf::Color ConcaveShape::getOutlineColor() const
+{
+	return mOutlineColor;
+}
+
+inline void ConcaveShape::setOutlineThickness(float outlineThickness)
+{
+	assert(outlineThickness >= 0.f);
+
+	mOutlineThickness = outlineThickness;
+	mNeedsOutlineUpdate = true;
+}
+
+inline float ConcaveShape::getOutlineThickness() const
+{
+	return mOutlineThickness;
+}
+
+inline void ConcaveShape::setMemoryArena(MemoryArena* arena)
+{
+	mArena = arena;
+}
+
+inline sf::FloatRect ConcaveShape::getLocalBounds() const
+{
+	ensureOutlineUpdated();
+	return mLocalBounds;
+}
+
+inline sf::FloatRect ConcaveShape::getGlobalBounds() const
+{
+	return getTransform().transformRect(getLocalBounds());
+}
+
+inline void ConcaveShape::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+	ensureDecomposed();
+	ensureOutlineUpdated();
+
+	states.transform *= getTransform();
+	target.draw(mTriangleVertices, states);
+
+	if (mOutlineThickness != 0.f)
+		target.draw(mOutlineVertices, states);
+}
+
+inline void ConcaveShape::ensureDecomposed() const
+{
+	if (!mNeedsDecomposition)
+		return;
+
+	// Without moved points, there is no previous decomposition to start from
+	if (mMovedPoints.empty() || !redecomposeMovedPoints())
+		decompose();
+
+	mMovedPoints.clear();
+
+	// Vertices are cheap to rebuild compared to the triangulation
+	mTriangleVertices.resize(mTriangles.size());
+	for (std::size_t i = 0; i < mTriangles.size(); ++i)
+		mTriangleVertices[i] = sf::Vertex(mPoints[mTriangles[i]], mFillColor);
+
+	mNeedsDecomposition = false;
+}
+
+inline void ConcaveShape::decompose() const
+{
+	// Use extra vector, to keep vertices order
+	detail::ArenaVector<Triangle<const sf::Vector2f>> triangles(mArena);
+	detail::triangulatePolygonImpl(mPoints.cbegin(), mPoints.cend(), std::back_inserter(triangles), detail::PolygonTrDetails(), mArena);
+
+	// Store the triangles as indices, so that they remain valid when points move
+	mTriangles.clear();
+	AURORA_FOREACH(const Triangle<const sf::Vector2f>& triangle, triangles)
+	{
+		for (unsigned int i = 0; i < 3; ++i)
+			mTriangles.push_back(static_cast<std::uint32_t>(&triangle[i] - mPoints.data()));
+	}
+}
+
+inline bool ConcaveShape::redecomposeMovedPoints() const
+{
+	const std::size_t pointCount = mPoints.size();
+
+	std::sort(mMovedPoints.begin(), mMovedPoints.end());
+	mMovedPoints.erase(std::unique(mMovedPoints.begin(), mMovedPoints.end()), mMovedPoints.end());
+
+	// Re-triangulating large regions is not cheaper than starting from scratch
+	if (4 * mMovedPoints.size() > pointCount)
+		return false;
+
+	// A moved point without triangles (e.g. a merged duplicate) might need some now
+	detail::ArenaVector<bool> region(pointCount, false, mArena);
+	AURORA_FOREACH(std::uint32_t index, mTriangles)
+		region[index] = true;
+
+	AURORA_FOREACH(std::uint32_t index, mMovedPoints)
+	{
+		if (!region[index])
+			return false;
+	}
+
+	region.assign(pointCount, false);
+	AURORA_FOREACH(std::uint32_t index, mMovedPoints)
+		region[index] = true;
+
+	// If the triangles around the moved points cannot be re-triangulated on their own, for example because a point moved
+	// across the opposite edge of its triangle, try again with the triangles around those
+	for (unsigned int attempt = 0; attempt < 4; ++attempt)
+	{
+		if (redecomposeRegion(region))
+			return true;
+	}
+
+	return false;
+}
+
+inline bool ConcaveShape::redecomposeRegion(detail::ArenaVector<bool>& region) const
+{
+	const std::uint32_t none = 0xFFFFFFFFu;
+	const std::size_t pointCount = mPoints.size();
+
+	// Split triangles into the ones that stay and the ones with a corner in the region. The latter are represented by their
+	// directed edges, as (from << 32 | to).
+	detail::ArenaVector<std::uint32_t> triangles(mArena);
+	detail::ArenaVector<std::uint64_t> removedEdges(mArena);
+	detail::ArenaVector<bool> covered(pointCount, false, mArena);
+
+	for (std::size_t i = 0; i < mTriangles.size(); i += 3)
+	{
+		const std::uint32_t* corners = &mTriangles[i];
+		if (region[corners[0]] || region[corners[1]] || region[corners[2]])
+		{
+			for (unsigned int j = 0; j < 3; ++j)
+			{
+				covered[corners[j]] = true;
+				removedEdges.push_back(std::uint64_t(corners[j]) << 32 | corners[(j+1) % 3]);
+			}
+		}
+		else
+		{
+			triangles.insert(triangles.end(), corners, corners + 3);
+		}
+	}
+
+	// On failure, the next attempt includes all corners of the removed triangles
+	region.swap(covered);
+
+	// The removed region is bounded by the edges whose opposite edge is not removed. Since all triangles are clockwise, these
+	// form clockwise loops around the region. Link them; a point with two outgoing edges makes the loops ambiguous.
+	std::sort(removedEdges.begin(), removedEdges.end());
+
+	detail::ArenaVector<std::uint32_t> nextPoint(pointCount, none, mArena);
+	detail::ArenaVector<std::uint32_t> loopStarts(mArena);
+	AURORA_FOREACH(std::uint64_t edge, removedEdges)
+	{
+		std::uint32_t from = static_cast<std::uint32_t>(edge >> 32);
+		std::uint32_t to = static_cast<std::uint32_t>(edge);
+
+		if (std::binary_search(removedEdges.begin(), removedEdges.end(), std::uint64_t(to) << 32 | from))
+			continue;
+
+		if (nextPoint[from] != none)
+			return false;
+
+		nextPoint[from] = to;
+		loopStarts.push_back(from);
+	}
+
+	// Re-triangulate every loop with the new point positions
+	detail::ArenaVector<std::uint32_t> loop(mArena);
+	detail::ArenaVector<sf::Vector2f> loopPositions(mArena);
+	detail::ArenaVector<Triangle<const sf::Vector2f>> loopTriangles(mArena);
+
+	AURORA_FOREACH(std::uint32_t start, loopStarts)
+	{
+		// Already part of an earlier loop
+		if (nextPoint[start] == none)
+			continue;
+
+		loop.clear();
+		loopPositions.clear();
+
+		std::uint32_t current = start;
+		do
+		{
+			std::uint32_t next = nextPoint[current];
+			if (next == none)
+				return false;
+
+			loop.push_back(current);
+			loopPositions.push_back(mPoints[current]);
+
+			nextPoint[current] = none;
+			current = next;
+		}
+		while (current != start);
+
+		// An overlapping loop could not be triangulated without covering other triangles. A counter-clockwise loop encloses a
+		// hole or has been turned inside out by the moved points.
+		if (!detail::isSimplePolygon(loopPositions) || !detail::isClockwisePolygon(loopPositions))
+			return false;
+
+		loopTriangles.clear();
+		detail::triangulatePolygonImpl(loopPositions.cbegin(), loopPositions.cend(), std::back_inserter(loopTriangles),
+			detail::PolygonTrDetails(), mArena);
+
+		// Coinciding points are merged by the triangulation, leaving some of them uncovered
+		if (loopTriangles.size() != loop.size() - 2)
+			return false;
+
+		AURORA_FOREACH(const Triangle<const sf::Vector2f>& triangle, loopTriangles)
+		{
+			for (unsigned int i = 0; i < 3; ++i)
+				triangles.push_back(loop[&triangle[i] - loopPositions.data()]);
+		}
+	}
+
+	mTriangles.assign(triangles.begin(), triangles.end());
+	return true;
+}
+
+inline void ConcaveShape::ensureOutlineUpdated() const
+{
+	if (!mNeedsOutlineUpdate)
+		return;
+
+	const std::size_t size = mPoints.size();
+	const float halfThickness = mOutlineThickness / 2.f;
+
+	// One closed strip along the outline, centered on the edges. At each point, the two sides meet at the miter, which is
+	// limited in length for sharp angles.
+	mOutlineVertices.clear();
+	if (mOutlineThickness != 0.f && size >= 2)
+	{
+		for (std::size_t i = 0; i <= size; ++i)
+		{
+			sf::Vector2f point = mPoints[i % size];
+			sf::Vector2f previous = mPoints[(i + size - 1) % size];
+			sf::Vector2f next = mPoints[(i + 1) % size];
+
+			sf::Vector2f nextNormal = detail::outlineNormal(point, next, sf::Vector2f());
+			sf::Vector2f previousNormal = detail::outlineNormal(previous, point, nextNormal);
+			if (nextNormal == sf::Vector2f())
+				nextNormal = previousNormal;
+
+			sf::Vector2f miter = previousNormal + nextNormal;
+			sf::Vector2f offset;
+			if (squaredLength(miter) > 1e-6f)
+			{
+				miter = unitVector(miter);
+				offset = miter * (halfThickness / std::max(dotProduct(miter, nextNormal), 0.25f));
+			}
+			else
+			{
+				// The outline turns back on itself
+				offset = previousNormal * halfThickness;
+			}
+
+			mOutlineVertices.append(sf::Vertex(point + offset, mOutlineColor));
+			mOutlineVertices.append(sf::Vertex(point - offset, mOutlineColor));
+		}
+	}
+
+	// Bounds include the outline
+	mLocalBounds = sf::FloatRect();
+	if (size != 0)
+	{
+		sf::Vector2f min = mPoints[0];
+		sf::Vector2f max = mPoints[0];
+
+		auto extend = [&] (sf::Vector2f point)
+		{
+			min.x = std::min(min.x, point.x);
+			min.y = std::min(min.y, point.y);
+			max.x = std::max(max.x, point.x);
+			max.y = std::max(max.y, point.y);
+		};
+
+		AURORA_FOREACH(sf::Vector2f point, mPoints)
+			extend(point);
+
+		for (std::size_t i = 0; i < mOutlineVertices.getVertexCount(); ++i)
+			extend(mOutlineVertices[i].position);
+
+		mLocalBounds = sf::FloatRect(min.x, min.y, max.x - min.x, max.y - min.y);
+	}
+
+	mNeedsOutlineUpdate = false;
+}
+
+} // namespace thor
@@ -0,0 +1,248 @@
+#include "TimerWheel.h"
+
+#include <cassert>
+
+constexpr std::uint32_t TimerWheel::INVALID_INDEX;
+
+////////////////////////////////////////////////////////////
+TimerWheel::TimerWheel(sf::Time t_tickLength)
+	: m_tickLength(t_tickLength)
+{
+	assert(t_tickLength > sf::Time::Zero);
+	m_buckets.fill(INVALID_INDEX);
+}
+
+////////////////////////////////////////////////////////////
+TimerWheel::TimerWheel(const ClockSource& t_clock, sf::Time t_tickLength)
+	: TimerWheel(t_tickLength)
+{
+	m_clock = &t_clock;
+	m_clockTime = t_clock.getElapsedTime();
+}
+
+////////////////////////////////////////////////////////////
+TimerWheel::Handle TimerWheel::schedule(sf::Time t_delay, std::function<void()> t_callback)
+{
+	// Round up to whole ticks, but fire no earlier than the next tick.
+	std::int64_t ticks = (t_delay.asMicroseconds() + m_tickLength.asMicroseconds() - 1) / m_tickLength.asMicroseconds();
+	if (ticks < 1)
+	{
+		ticks = 1;
+	}
+
+	std::uint32_t index = allocate();
+	Node& node = m_nodes[index];
+	node.callback = std::move(t_callback);
+	node.expiry = m_currentTick + static_cast<std::uint64_t>(ticks);
+	link(index);
+	++m_pending;
+
+	Handle handle;
+	handle.index = index;
+	handle.generation = node.generation;
+	return handle;
+}
+
+////////////////////////////////////////////////////////////
+bool TimerWheel::cancel(Handle t_handle)
+{
+	if (!isPending(t_handle))
+	{
+		return false;
+	}
+
+	unlink(t_handle.index);
+	release(t_handle.index);
+	--m_pending;
+	return true;
+}
+
+////////////////////////////////////////////////////////////
+bool TimerWheel::isPending(Handle t_handle) const
+{
+	return t_handle.index < m_nodes.size()
+		&& m_nodes[t_handle.index].generation == t_handle.generation
+		&& m_nodes[t_handle.index].bucket != INVALID_INDEX;
+}
+
+////////////////////////////////////////////////////////////
+sf::Time TimerWheel::getRemainingTime(Handle t_handle) const
+{
+	if (!isPending(t_handle))
+	{
+		return sf::Time::Zero;
+	}
+
+	std::uint64_t ticksLeft = m_nodes[t_handle.index].expiry - m_currentTick;
+	sf::Time remaining = sf::microseconds(static_cast<sf::Int64>(ticksLeft) * m_tickLength.asMicroseconds()) - m_accumulator;
+	return remaining > sf::Time::Zero ? remaining : sf::Time::Zero;
+}
+
+////////////////////////////////////////////////////////////
+void TimerWheel::advance(sf::Time t_dt)
+{
+	m_accumulator += t_dt;
+	while (m_accumulator >= m_tickLength)
+	{
+		m_accumulator -= m_tickLength;
+		tick();
+	}
+
+	// Invoke the whole batch only after the wheel is consistent again, so that
+	//  callbacks are free to schedule or cancel timers.
+	for (std::function<void()>& callback : m_expired)
+	{
+		callback();
+	}
+	m_expired.clear();
+}
+
+////////////////////////////////////////////////////////////
+void TimerWheel::update()
+{
+	assert(m_clock);
+	sf::Time now = m_clock->getElapsedTime();
+	sf::Time elapsed = now - m_clockTime;
+	m_clockTime = now;
+	advance(elapsed);
+}
+
+////////////////////////////////////////////////////////////
+void TimerWheel::clear()
+{
+	for (std::uint32_t i = 0; i < m_nodes.size(); ++i)
+	{
+		if (m_nodes[i].bucket != INVALID_INDEX)
+		{
+			release(i);
+		}
+	}
+	m_buckets.fill(INVALID_INDEX);
+	m_pending = 0;
+}
+
+////////////////////////////////////////////////////////////
+std::size_t TimerWheel::size() const
+{
+	return m_pending;
+}
+
+////////////////////////////////////////////////////////////
+void TimerWheel::tick()
+{
+	++m_currentTick;
+
+	// When the lowest level wraps around, refill it from the level above,
+	//  and so on for as long as levels keep wrapping.
+	for (int level = 1; level < LEVELS; ++level)
+	{
+		if (((m_currentTick >> (SLOT_BITS * (level - 1))) & SLOT_MASK) != 0)
+		{
+			break;
+		}
+		cascade(level);
+	}
+
+	std::uint32_t& head = m_buckets[m_currentTick & SLOT_MASK];
+	while (head != INVALID_INDEX)
+	{
+		std::uint32_t index = head;
+		unlink(index);
+		m_expired.push_back(std::move(m_nodes[index].callback));
+		release(index);
+		--m_pending;
+	}
+}
+
+////////////////////////////////////////////////////////////
+void TimerWheel::cascade(int t_level)
+{
+	std::uint64_t slot = (m_currentTick >> (SLOT_BITS * t_level)) & SLOT_MASK;
+	std::uint32_t& head = m_buckets[t_level * SLOTS + slot];
+
+	// Detach the whole list first; re-linking never targets this bucket again.
+	std::uint32_t index = head;
+	head = INVALID_INDEX;
+	while (index != INVALID_INDEX)
+	{
+		std::uint32_t next = m_nodes[index].next;
+		link(index);
+		index = next;
+	}
+}
+
+////////////////////////////////////////////////////////////
+void TimerWheel::link(std::uint32_t t_index)
+{
+	Node& node = m_nodes[t_index];
+
+	// Timers that are already due fire on the current tick if it is still being
+	//  processed, which can only happen while cascading.
+	std::uint64_t expiry = node.expiry < m_currentTick ? m_currentTick : node.expiry;
+	std::uint64_t delta = expiry - m_currentTick;
+	if (delta >= MAX_RANGE)
+	{
+		expiry = m_currentTick + MAX_RANGE - 1;
+		delta = MAX_RANGE - 1;
+	}
+
+	int level = 0;
+	while (level < LEVELS - 1 && delta >= (std::uint64_t(1) << (SLOT_BITS * (level + 1))))
+	{
+		++level;
+	}
+
+	std::uint32_t bucket = static_cast<std::uint32_t>(level * SLOTS + ((expiry >> (SLOT_BITS * level)) & SLOT_MASK));
+	node.bucket = bucket;
+	node.prev = INVALID_INDEX;
+	node.next = m_buckets[bucket];
+	if (node.next != INVALID_INDEX)
+	{
+		m_nodes[node.next].prev = t_index;
+	}
+	m_buckets[bucket] = t_index;
+}
+
+////////////////////////////////////////////////////////////
+void TimerWheel::unlink(std::uint32_t t_index)
+{
+	Node& node = m_nodes[t_index];
+	if (node.prev != INVALID_INDEX)
+	{
+		m_nodes[node.prev].next = node.next;
+	}
+	else
+	{
+		m_buckets[node.bucket] = node.next;
+	}
+	if (node.next != INVALID_INDEX)
+	{
+		m_nodes[node.next].prev = node.prev;
+	}
+	node.prev = INVALID_INDEX;
+	node.next = INVALID_INDEX;
+}
+
+////////////////////////////////////////////////////////////
+void TimerWheel::release(std::uint32_t t_index)
+{
+	Node& node = m_nodes[t_index];
+	node.callback = nullptr;
+	node.bucket = INVALID_INDEX;
+	++node.generation;
+	m_freeList.push_back(t_index);
+}
+
+////////////////////////////////////////////////////////////
+std::uint32_t TimerWheel::allocate()
+{
+	if (!m_freeList.empty())
+	{
+		std::uint32_t index = m_freeList.back();
+		m_freeList.pop_back();
+		return index;
+	}
+
+	m_nodes.emplace_back();
+	return static_cast<std::uint32_t>(m_nodes.size() - 1);
+}
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <SFML/System/Time.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "SimulationClock.h"
+
+/// <summary>
+/// @brief Hierarchical timer wheel driven by the simulation tick.
+///
+/// Every thor::Timer owns its own sf::Clock, so polling thousands of per-entity
+///  cooldowns costs one OS clock read each. The wheel instead stores all pending
+///  timers in buckets of ticks and is advanced once per simulation step, so
+///  scheduling and cancelling are O(1) and only the timers that actually expire
+///  are touched. Callbacks of all timers that expire during one advance() are
+///  invoked together, in the order of their expiry tick.
+///
+/// Time only moves when advance() or update() is called, which keeps timers deterministic.
+///  A wheel attached to a ClockSource follows that clock in update(), so pausing or
+///  scaling the game's SimulationClock pauses or scales all of its timers.
+/// Example usage:
+///		TimerWheel wheel(simulationClock, sf::milliseconds(10));
+///		TimerWheel::Handle h = wheel.schedule(sf::milliseconds(500), [] { std::cout << "fire"; });
+///		simulationClock.advance(step);
+///		wheel.update();
+/// </summary>
+class TimerWheel : private sf::NonCopyable
+{
+public:
+	/// <summary>
+	/// @brief Identifies a scheduled timer.
+	/// A handle is invalidated when its timer fires or is cancelled, even if the
+	///  underlying slot is reused for another timer later.
+	/// </summary>
+	struct Handle
+	{
+		std::uint32_t index{ INVALID_INDEX };
+		std::uint32_t generation{ 0 };
+	};
+
+	/// <summary>
+	/// @brief Creates an empty wheel.
+	/// </summary>
+	/// <param name="t_tickLength">The duration of one tick, normally the fixed update step</param>
+	explicit TimerWheel(sf::Time t_tickLength);
+
+	/// <summary>
+	/// @brief Creates an empty wheel that follows a clock source in update().
+	/// The clock source must outlive the wheel.
+	/// </summary>
+	/// <param name="t_clock">The clock whose time drives the timers, normally the SimulationClock</param>
+	/// <param name="t_tickLength">The duration of one tick, normally the fixed update step</param>
+	TimerWheel(const ClockSource& t_clock, sf::Time t_tickLength);
+
+	/// <summary>
+	/// @brief Schedules a callback to be invoked after the given delay.
+	/// The delay is rounded up to whole ticks, and is at least one tick.
+	/// </summary>
+	/// <param name="t_delay">Simulated time until the callback fires</param>
+	/// <param name="t_callback">The function invoked on expiry</param>
+	/// <returns>A handle that can be used to cancel or query the timer.</returns>
+	Handle schedule(sf::Time t_delay, std::function<void()> t_callback);
+
+	/// <summary>
+	/// @brief Removes a pending timer without invoking its callback.
+	/// </summary>
+	/// <param name="t_handle">The timer to cancel</param>
+	/// <returns>true if the timer was pending, false if it had already fired or been cancelled.</returns>
+	bool cancel(Handle t_handle);
+
+	/// <summary>
+	/// @brief Returns true if the timer has neither fired nor been cancelled.
+	/// </summary>
+	bool isPending(Handle t_handle) const;
+
+	/// <summary>
+	/// @brief Returns the simulated time left until the timer fires.
+	/// If the timer is no longer pending, sf::Time::Zero is returned.
+	/// </summary>
+	sf::Time getRemainingTime(Handle t_handle) const;
+
+	/// <summary>
+	/// @brief Advances the wheel by the given amount of simulated time.
+	/// Whole ticks are processed and the remainder is carried over to the next call.
+	/// The callbacks of all timers that expired are then invoked in one batch.
+	/// Callbacks may schedule or cancel timers.
+	/// </summary>
+	/// <param name="t_dt">Simulated time since the last call</param>
+	void advance(sf::Time t_dt);
+
+	/// <summary>
+	/// @brief Advances the wheel by the time the attached clock moved since the last update().
+	/// Only valid for a wheel constructed with a clock source.
+	/// </summary>
+	void update();
+
+	/// <summary>
+	/// @brief Removes all pending timers without invoking them.
+	/// </summary>
+	void clear();
+
+	/// <summary>
+	/// @brief Returns the number of timers that are currently pending.
+	/// </summary>
+	std::size_t size() const;
+
+private:
+	static constexpr std::uint32_t INVALID_INDEX{ 0xFFFFFFFFu };
+	static constexpr int SLOT_BITS{ 6 };
+	static constexpr int SLOTS{ 1 << SLOT_BITS };
+	static constexpr std::uint64_t SLOT_MASK{ SLOTS - 1 };
+	static constexpr int LEVELS{ 4 };
+	// Any delay beyond this is parked in the top level and re-evaluated on cascade.
+	static constexpr std::uint64_t MAX_RANGE{ std::uint64_t(1) << (SLOT_BITS * LEVELS) };
+
+	struct Node
+	{
+		std::function<void()> callback;
+		std::uint64_t expiry{ 0 };
+		std::uint32_t prev{ INVALID_INDEX };
+		std::uint32_t next{ INVALID_INDEX };
+		std::uint32_t generation{ 0 };
+		// Bucket this node is linked into, or INVALID_INDEX if the node is free.
+		std::uint32_t bucket{ INVALID_INDEX };
+	};
+
+	// Processes a single tick: cascades higher levels and collects expired timers.
+	void tick();
+
+	// Moves all timers of the current bucket of a higher level down into lower levels.
+	void cascade(int t_level);
+
+	// Links a node into the bucket matching its expiry tick.
+	void link(std::uint32_t t_index);
+
+	// Unlinks a node from its bucket.
+	void unlink(std::uint32_t t_index);
+
+	// Returns a node to the free list and invalidates outstanding handles.
+	void release(std::uint32_t t_index);
+
+	std::uint32_t allocate();
+
+	const sf::Time m_tickLength;
+	sf::Time m_accumulator;
+
+	// Clock followed by update(), or nullptr if the wheel is only advanced manually.
+	const ClockSource* m_clock{ nullptr };
+	// Clock time at the last update().
+	sf::Time m_clockTime;
+
+	// Number of ticks processed so far.
+	std::uint64_t m_currentTick{ 0 };
+
+	std::vector<Node> m_nodes;
+	std::vector<std::uint32_t> m_freeList;
+	std::array<std::uint32_t, SLOTS * LEVELS> m_buckets;
+	std::size_t m_pending{ 0 };
+
+	// Callbacks collected during advance(), reused across frames to avoid reallocation.
+	std::vector<std::function<void()>> m_expired;
+};
@@ -0,0 +1,98 @@
+/// <summary>
+/// @brief Compares the startup cost of loading images from loose files and from an asset pack.
+///
+/// Usage:
+///		AssetPackBenchmark <pack file> <base directory> <file>... [-n <repetitions>]
+/// The files are the same relative names that were given to the AssetPacker.
+///  Each repetition opens the sources from scratch and decodes every image into an
+///  sf::Image, which is the part of texture loading that happens on the CPU.
+/// Note that after the first repetition, both variants read from the OS file cache.
+/// Build it together with Thor/Resources/Detail/MappedFile.cpp, which maps the pack.
+/// </summary>
+
+#include <Thor/Resources/AssetPack.hpp>
+#include <SFML/Graphics/Image.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+	typedef std::chrono::steady_clock Clock;
+
+	double millisecondsSince(Clock::time_point t_start)
+	{
+		return std::chrono::duration<double, std::milli>(Clock::now() - t_start).count();
+	}
+}
+
+////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+	if (argc < 4)
+	{
+		std::cerr << "Usage: AssetPackBenchmark <pack file> <base directory> <file>... [-n <repetitions>]\n";
+		return 1;
+	}
+
+	std::string packFile = argv[1];
+	std::string baseDirectory = argv[2];
+	std::vector<std::string> names;
+	int repetitions = 20;
+	for (int i = 3; i < argc; ++i)
+	{
+		if (std::string(argv[i]) == "-n" && i + 1 < argc)
+		{
+			repetitions = std::atoi(argv[++i]);
+		}
+		else
+		{
+			names.push_back(argv[i]);
+		}
+	}
+
+	double looseTime = 0.0;
+	double packTime = 0.0;
+	for (int repetition = 0; repetition < repetitions; ++repetition)
+	{
+		Clock::time_point start = Clock::now();
+		for (const std::string& name : names)
+		{
+			sf::Image image;
+			if (!image.loadFromFile(baseDirectory + "/" + name))
+			{
+				std::cerr << "Cannot load " << name << "\n";
+				return 1;
+			}
+		}
+		looseTime += millisecondsSince(start);
+
+		start = Clock::now();
+		thor::AssetPack pack;
+		if (!pack.open(packFile))
+		{
+			std::cerr << "Cannot open " << packFile << "\n";
+			return 1;
+		}
+		for (const std::string& name : names)
+		{
+			std::size_t size = 0;
+			const void* data = pack.find(name, size);
+			sf::Image image;
+			if (!data || !image.loadFromMemory(data, size))
+			{
+				std::cerr << "Cannot load " << name << " from pack\n";
+				return 1;
+			}
+		}
+		packTime += millisecondsSince(start);
+	}
+
+	std::cout << names.size() << " images, " << repetitions << " repetitions\n";
+	std::cout << "loose files: " << looseTime / repetitions << " ms per startup\n";
+	std::cout << "asset pack:  " << packTime / repetitions << " ms per startup\n";
+	return 0;
+}
@@ -0,0 +1,143 @@
+/// <summary>
+/// @brief Offline tool that packs asset files into a single thor::AssetPack file.
+///
+/// Usage:
+///		AssetPacker <output.pack> <base directory> <file>...
+/// Files are given relative to the base directory, and that relative path is the
+///  name under which the asset is found in the pack. Example:
+///		AssetPacker resources/assets.pack resources/assets graphics/SpriteSheet.png graphics/TimingBar.png
+/// </summary>
+
+#include <Thor/Resources/AssetPack.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace
+{
+	// Blobs start at multiples of this, so that decoders can read them with aligned loads.
+	const std::uint32_t BLOB_ALIGNMENT = 16;
+
+	struct Asset
+	{
+		std::string name;
+		std::vector<char> bytes;
+	};
+
+	std::uint64_t alignUp(std::uint64_t t_value, std::uint64_t t_alignment)
+	{
+		return (t_value + t_alignment - 1) / t_alignment * t_alignment;
+	}
+
+	bool readFile(const std::string& t_filename, std::vector<char>& t_bytes)
+	{
+		std::ifstream file(t_filename, std::ios::binary);
+		if (!file)
+		{
+			return false;
+		}
+		t_bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+		return true;
+	}
+
+	void pad(std::ofstream& t_file, std::uint64_t t_offset)
+	{
+		static const char zeros[BLOB_ALIGNMENT] = {};
+		t_file.write(zeros, alignUp(t_offset, BLOB_ALIGNMENT) - t_offset);
+	}
+}
+
+////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+	if (argc < 4)
+	{
+		std::cerr << "Usage: AssetPacker <output.pack> <base directory> <file>...\n";
+		return 1;
+	}
+
+	std::string output = argv[1];
+	std::string baseDirectory = argv[2];
+
+	std::vector<Asset> assets;
+	for (int i = 3; i < argc; ++i)
+	{
+		Asset asset;
+		asset.name = argv[i];
+		if (!readFile(baseDirectory + "/" + asset.name, asset.bytes))
+		{
+			std::cerr << "Cannot read " << baseDirectory << "/" << asset.name << "\n";
+			return 1;
+		}
+		assets.push_back(std::move(asset));
+	}
+
+	// AssetPack::find() does a binary search over the index.
+	std::sort(assets.begin(), assets.end(), [](const Asset& t_lhs, const Asset& t_rhs) { return t_lhs.name < t_rhs.name; });
+	auto duplicate = std::adjacent_find(assets.begin(), assets.end(), [](const Asset& t_lhs, const Asset& t_rhs) { return t_lhs.name == t_rhs.name; });
+	if (duplicate != assets.end())
+	{
+		std::cerr << "Duplicate asset " << duplicate->name << "\n";
+		return 1;
+	}
+
+	thor::detail::PackHeader header;
+	std::copy(thor::detail::PackMagic, thor::detail::PackMagic + 4, header.magic);
+	header.version = thor::detail::PackVersion;
+	header.entryCount = static_cast<std::uint32_t>(assets.size());
+	header.alignment = BLOB_ALIGNMENT;
+
+	// Lay out the name table, then the blobs.
+	std::vector<thor::detail::PackEntry> entries(assets.size());
+	std::uint32_t nameOffset = 0;
+	for (std::size_t i = 0; i < assets.size(); ++i)
+	{
+		entries[i].nameOffset = nameOffset;
+		entries[i].nameLength = static_cast<std::uint32_t>(assets[i].name.size());
+		nameOffset += entries[i].nameLength;
+	}
+
+	std::uint64_t offset = sizeof(header) + entries.size() * sizeof(thor::detail::PackEntry) + nameOffset;
+	for (std::size_t i = 0; i < assets.size(); ++i)
+	{
+		offset = alignUp(offset, BLOB_ALIGNMENT);
+		entries[i].offset = offset;
+		entries[i].size = assets[i].bytes.size();
+		offset += entries[i].size;
+	}
+
+	std::ofstream file(output, std::ios::binary);
+	if (!file)
+	{
+		std::cerr << "Cannot write " << output << "\n";
+		return 1;
+	}
+
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(thor::detail::PackEntry));
+	for (const Asset& asset : assets)
+	{
+		file.write(asset.name.data(), asset.name.size());
+	}
+
+	std::uint64_t written = sizeof(header) + entries.size() * sizeof(thor::detail::PackEntry) + nameOffset;
+	for (std::size_t i = 0; i < assets.size(); ++i)
+	{
+		pad(file, written);
+		file.write(assets[i].bytes.data(), assets[i].bytes.size());
+		written = entries[i].offset + entries[i].size;
+	}
+
+	if (!file)
+	{
+		std::cerr << "Error writing " << output << "\n";
+		return 1;
+	}
+
+	std::cout << "Packed " << assets.size() << " assets, " << written << " bytes\n";
+	return 0;
+}
@@ -0,0 +1,167 @@
+/// <summary>
+/// @brief Compares thor::EventSystem's flat listener table with the multimap it replaces.
+///
+/// Usage:
+///		EventListenerBenchmark [-e <events>] [-l <listeners per id>]
+/// The same enum is used as event identifier twice: once opted into the flat table
+///  through thor::DenseTriggerTraits, once with the default multimap. Events cycle
+///  through 4 identifiers. Afterwards, listeners are connected to identifiers
+///  outside of the table (-1 and one past the end), which must still be called and
+///  must not grow the table, and half of the listeners are disconnected again.
+///  Finally a listener connects and disconnects listeners of its own event while it is
+///  called; the new ones must only receive the following events.
+/// </summary>
+
+#include <Thor/Input/EventSystem.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+	typedef std::chrono::steady_clock Clock;
+
+	double secondsSince(Clock::time_point t_start)
+	{
+		return std::chrono::duration<double>(Clock::now() - t_start).count();
+	}
+
+	enum class DenseId
+	{
+		Unknown = -1,
+		A, B, C, D,
+		Count
+	};
+
+	enum class SparseId
+	{
+		Unknown = -1,
+		A, B, C, D,
+		Count
+	};
+
+	const int EVENT_IDS = 4;
+
+	template <typename Id>
+	struct BenchmarkEvent
+	{
+		Id id;
+	};
+
+	// Found by EventSystem through argument-dependent lookup.
+	template <typename Id>
+	Id getEventId(const BenchmarkEvent<Id>& t_event)
+	{
+		return t_event.id;
+	}
+
+	// Returns the number of listener calls per second, and the total number of calls in t_calls.
+	template <typename Id>
+	double measure(std::size_t t_events, int t_listenersPerId, std::size_t& t_calls)
+	{
+		thor::EventSystem<BenchmarkEvent<Id>, Id> system;
+		t_calls = 0;
+		for (int id = 0; id < EVENT_IDS; ++id)
+		{
+			for (int i = 0; i < t_listenersPerId; ++i)
+			{
+				std::size_t* calls = &t_calls;
+				system.connect0(static_cast<Id>(id), [calls] { ++*calls; });
+			}
+		}
+
+		Clock::time_point start = Clock::now();
+		for (std::size_t i = 0; i < t_events; ++i)
+		{
+			system.triggerEvent(BenchmarkEvent<Id>{ static_cast<Id>(i % EVENT_IDS) });
+		}
+		return t_events / secondsSince(start);
+	}
+}
+
+namespace thor
+{
+	template <>
+	struct DenseTriggerTraits<DenseId>
+	{
+		static const bool			isDense = true;
+		static const std::size_t	count = static_cast<std::size_t>(DenseId::Count);
+	};
+}
+
+////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+	std::size_t eventCount = 20000000;
+	int listenersPerId = 1;
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		std::string option = argv[i];
+		if (option == "-e")
+		{
+			eventCount = std::strtoul(argv[i + 1], nullptr, 10);
+		}
+		else if (option == "-l")
+		{
+			listenersPerId = std::atoi(argv[i + 1]);
+		}
+	}
+
+	std::size_t denseCalls = 0;
+	std::size_t sparseCalls = 0;
+	double dense = measure<DenseId>(eventCount, listenersPerId, denseCalls);
+	double sparse = measure<SparseId>(eventCount, listenersPerId, sparseCalls);
+	std::size_t expected = eventCount * listenersPerId;
+	std::cout << "flat table: " << dense / 1e6 << " M events/s, " << (denseCalls == expected ? "all delivered" : "MISSING CALLS") << "\n";
+	std::cout << "multimap:   " << sparse / 1e6 << " M events/s, " << (sparseCalls == expected ? "all delivered" : "MISSING CALLS") << "\n";
+
+	// Identifiers outside of the table fall back to the multimap.
+	thor::EventSystem<BenchmarkEvent<DenseId>, DenseId> system;
+	int outside = 0;
+	int inside = 0;
+	thor::Connection unknown = system.connect0(DenseId::Unknown, [&outside] { ++outside; });
+	system.connect0(DenseId::Count, [&outside] { ++outside; });
+	thor::Connection a = system.connect0(DenseId::A, [&inside] { ++inside; });
+	system.connect0(DenseId::A, [&inside] { ++inside; });
+	system.triggerEvent(BenchmarkEvent<DenseId>{ DenseId::Unknown });
+	system.triggerEvent(BenchmarkEvent<DenseId>{ DenseId::Count });
+	system.triggerEvent(BenchmarkEvent<DenseId>{ DenseId::A });
+
+	unknown.disconnect();
+	a.disconnect();
+	system.triggerEvent(BenchmarkEvent<DenseId>{ DenseId::Unknown });
+	system.triggerEvent(BenchmarkEvent<DenseId>{ DenseId::A });
+
+	bool passed = outside == 2 && inside == 3;
+	std::cout << "identifiers outside of the table: " << (passed ? "passed" : "FAILED") << "\n";
+
+	// Connecting 100 listeners from within a listener appends to the slots that are being called.
+	thor::EventSystem<BenchmarkEvent<DenseId>, DenseId> reentrant;
+	int added = 0;
+	int connector = 0;
+	std::vector<thor::Connection> connections;
+	reentrant.connect0(DenseId::B, [&]
+	{
+		++connector;
+		for (int i = 0; i < 100; ++i)
+		{
+			connections.push_back(reentrant.connect0(DenseId::B, [&added] { ++added; }));
+		}
+		// Disconnecting leaves tombstones, which must not be reused during the call.
+		for (std::size_t i = connections.size() - 50; i < connections.size(); ++i)
+		{
+			connections[i].disconnect();
+		}
+	});
+	reentrant.triggerEvent(BenchmarkEvent<DenseId>{ DenseId::B });
+	bool firstCall = connector == 1 && added == 0;
+	reentrant.triggerEvent(BenchmarkEvent<DenseId>{ DenseId::B });
+	bool secondCall = connector == 2 && added == 50;
+
+	bool reentrantPassed = firstCall && secondCall;
+	std::cout << "connecting from within a listener: " << (reentrantPassed ? "passed" : "FAILED") << "\n";
+	return passed && reentrantPassed ? 0 : 1;
+}
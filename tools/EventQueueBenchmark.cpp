@@ -0,0 +1,197 @@
+/// <summary>
+/// @brief Measures the throughput of thor::EventSystem's queued dispatch mode.
+///
+/// Usage:
+///		EventQueueBenchmark [-e <events>] [-q <queue capacity>] [-t <max producers>]
+/// Producer threads queue events with 8 different ids, each with one listener,
+///  while the main thread drains the queue with dispatchQueuedEvents(). This is
+///  repeated for 1, 2, 4... up to the given number of producers (all hardware
+///  threads by default). The synchronous triggerEvent() is measured as a baseline.
+/// Producers retry while the queue is full, so every event must reach its listener
+///  exactly once, which serves as a sanity check. Heap allocations during the drains
+///  are counted by replacing the global operator new; there should be none.
+/// </summary>
+
+#include <Thor/Input/EventSystem.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	typedef std::chrono::steady_clock Clock;
+
+	double secondsSince(Clock::time_point t_start)
+	{
+		return std::chrono::duration<double>(Clock::now() - t_start).count();
+	}
+
+	const int EVENT_IDS = 8;
+
+	struct BenchmarkEvent
+	{
+		int id;
+	};
+
+	// Found by EventSystem through argument-dependent lookup.
+	int getEventId(const BenchmarkEvent& t_event)
+	{
+		return t_event.id;
+	}
+
+	typedef thor::EventSystem<BenchmarkEvent, int> BenchmarkEventSystem;
+
+	// Only counted while a drain runs, so that thread startup does not show up.
+	std::atomic<bool> g_countAllocations{ false };
+	std::atomic<std::size_t> g_heapAllocations{ 0 };
+
+	// Connects one listener per id that counts the events it receives.
+	void connectCounters(BenchmarkEventSystem& t_system, std::vector<std::size_t>& t_counts)
+	{
+		t_counts.assign(EVENT_IDS, 0);
+		for (int id = 0; id < EVENT_IDS; ++id)
+		{
+			std::size_t* count = &t_counts[id];
+			t_system.connect(id, [count](const BenchmarkEvent&) { ++*count; });
+		}
+	}
+
+	std::size_t sum(const std::vector<std::size_t>& t_counts)
+	{
+		std::size_t total = 0;
+		for (std::size_t count : t_counts)
+		{
+			total += count;
+		}
+		return total;
+	}
+}
+
+////////////////////////////////////////////////////////////
+void* operator new(std::size_t t_size)
+{
+	if (g_countAllocations)
+	{
+		++g_heapAllocations;
+	}
+	if (void* memory = std::malloc(t_size != 0 ? t_size : 1))
+	{
+		return memory;
+	}
+	throw std::bad_alloc();
+}
+
+////////////////////////////////////////////////////////////
+void operator delete(void* t_memory) noexcept
+{
+	std::free(t_memory);
+}
+
+////////////////////////////////////////////////////////////
+void operator delete(void* t_memory, std::size_t) noexcept
+{
+	std::free(t_memory);
+}
+
+////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+	std::size_t eventCount = 4000000;
+	std::size_t queueCapacity = 65536;
+	unsigned maxProducers = std::max(1u, std::thread::hardware_concurrency());
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		std::string option = argv[i];
+		if (option == "-e")
+		{
+			eventCount = std::strtoul(argv[i + 1], nullptr, 10);
+		}
+		else if (option == "-q")
+		{
+			queueCapacity = std::strtoul(argv[i + 1], nullptr, 10);
+		}
+		else if (option == "-t")
+		{
+			maxProducers = std::max(1, std::atoi(argv[i + 1]));
+		}
+	}
+
+	std::cout << eventCount << " events, " << EVENT_IDS << " ids, queue capacity " << queueCapacity << "\n";
+
+	// Synchronous baseline
+	{
+		BenchmarkEventSystem system;
+		std::vector<std::size_t> counts;
+		connectCounters(system, counts);
+
+		Clock::time_point start = Clock::now();
+		for (std::size_t i = 0; i < eventCount; ++i)
+		{
+			system.triggerEvent(BenchmarkEvent{ static_cast<int>(i % EVENT_IDS) });
+		}
+		double seconds = secondsSince(start);
+		std::cout << "triggerEvent: " << eventCount / seconds / 1e6 << " M events/s, "
+			<< (sum(counts) == eventCount ? "all delivered" : "MISSING EVENTS") << "\n";
+	}
+
+	for (unsigned producers = 1; producers <= maxProducers; producers *= 2)
+	{
+		BenchmarkEventSystem system(queueCapacity);
+		std::vector<std::size_t> counts;
+		connectCounters(system, counts);
+
+		// Producers retry while the queue is full, so every event arrives eventually.
+		std::atomic<unsigned> finished{ 0 };
+		std::vector<std::thread> threads;
+		std::size_t perProducer = eventCount / producers;
+		Clock::time_point start = Clock::now();
+		for (unsigned p = 0; p < producers; ++p)
+		{
+			threads.emplace_back([&system, &finished, perProducer, p]
+			{
+				for (std::size_t i = 0; i < perProducer; ++i)
+				{
+					while (!system.queueEvent(BenchmarkEvent{ static_cast<int>((i + p) % EVENT_IDS) }))
+					{
+						std::this_thread::yield();
+					}
+				}
+				++finished;
+			});
+		}
+
+		// All buffers are reserved up front, so draining should not touch the heap.
+		std::size_t drains = 0;
+		g_heapAllocations = 0;
+		while (finished < producers)
+		{
+			g_countAllocations = true;
+			system.dispatchQueuedEvents();
+			g_countAllocations = false;
+			++drains;
+		}
+		g_countAllocations = true;
+		system.dispatchQueuedEvents();
+		g_countAllocations = false;
+		double seconds = secondsSince(start);
+
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+
+		std::size_t expected = perProducer * producers;
+		std::cout << producers << " producers: " << expected / seconds / 1e6 << " M events/s, " << drains << " drains, "
+			<< g_heapAllocations << " heap allocations while draining, "
+			<< (sum(counts) == expected ? "all delivered" : "MISSING EVENTS") << "\n";
+	}
+
+	return 0;
+}
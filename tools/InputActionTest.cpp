@@ -0,0 +1,99 @@
+/// <summary>
+/// @brief Checks how InputAction programs evaluate in InputActionMap, including the operators on empty actions.
+///
+/// Usage:
+///		InputActionTest
+/// Only event based actions are used, so no keyboard or window is needed: every case
+///  pushes the events of one frame, runs update() and compares isActive() with the
+///  expected result. The exit code is 1 if any case fails.
+/// </summary>
+
+#include "../InputActionMap.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+	sf::Event keyPressed(sf::Keyboard::Key t_key)
+	{
+		sf::Event event;
+		event.type = sf::Event::KeyPressed;
+		event.key.code = t_key;
+		event.key.alt = false;
+		event.key.control = false;
+		event.key.shift = false;
+		event.key.system = false;
+		return event;
+	}
+
+	// Evaluates the action for one frame with the given events.
+	bool evaluate(const InputAction& t_action, const std::vector<sf::Event>& t_events)
+	{
+		InputActionMap map;
+		map.setAction(0, t_action);
+		map.clearEvents();
+		for (const sf::Event& event : t_events)
+		{
+			map.pushEvent(event);
+		}
+		map.update();
+		return map.isActive(0);
+	}
+
+	int g_failures = 0;
+
+	void check(const std::string& t_name, bool t_actual, bool t_expected)
+	{
+		std::cout << t_name << ": " << (t_actual == t_expected ? "passed" : "FAILED") << "\n";
+		if (t_actual != t_expected)
+		{
+			++g_failures;
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////
+int main()
+{
+	const InputAction empty;
+	const InputAction pressX(sf::Keyboard::X, InputAction::PressOnce);
+	const InputAction pressY(sf::Keyboard::Y, InputAction::PressOnce);
+	const std::vector<sf::Event> none;
+	const std::vector<sf::Event> x{ keyPressed(sf::Keyboard::X) };
+	const std::vector<sf::Event> xy{ keyPressed(sf::Keyboard::X), keyPressed(sf::Keyboard::Y) };
+
+	check("press X without events", evaluate(pressX, none), false);
+	check("press X", evaluate(pressX, x), true);
+	check("X and Y, only X", evaluate(pressX && pressY, x), false);
+	check("X and Y", evaluate(pressX && pressY, xy), true);
+	check("X or Y, only X", evaluate(pressX || pressY, x), true);
+	check("not X", evaluate(!pressX, none), true);
+	check("not X, X pressed", evaluate(!pressX, x), false);
+
+	// An empty action is never active and its negation always is, also without asserts.
+	check("empty", evaluate(empty, x), false);
+	check("empty and X", evaluate(empty && pressX, x), false);
+	check("empty or X", evaluate(empty || pressX, x), true);
+	check("not empty", evaluate(!empty, none), true);
+	check("not empty is not empty", (!empty).isEmpty(), false);
+	check("not not empty", evaluate(!!empty, x), false);
+	check("not not empty is empty", (!!empty).isEmpty(), true);
+	check("not empty and X", evaluate(!empty && pressX, x), true);
+	check("not empty and X, no events", evaluate(!empty && pressX, none), false);
+
+	// Several actions share one program; the values must not leak between them.
+	InputActionMap map;
+	map.setAction(0, !empty);
+	map.setAction(1, empty);
+	map.setAction(2, !pressX);
+	map.setAction(3, pressX || !empty);
+	map.clearEvents();
+	map.pushEvent(keyPressed(sf::Keyboard::X));
+	map.update();
+	check("shared program", map.isActive(0) && !map.isActive(1) && !map.isActive(2) && map.isActive(3), true);
+
+	std::cout << (g_failures == 0 ? "all passed" : "FAILURES") << "\n";
+	return g_failures == 0 ? 0 : 1;
+}
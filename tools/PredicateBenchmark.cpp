@@ -0,0 +1,198 @@
+/// <summary>
+/// @brief Measures the exact predicates thor::orientation() and thor::inCircle() against plain double arithmetic.
+///
+/// Usage:
+///		PredicateBenchmark [-n <tests>]
+/// Each predicate is timed on random points, where the fast double filter decides
+///  nearly every test, and on degenerate ones, where the exact fallback is needed
+///  often: points on common lines and circles, half of them moved by one ulp.
+///  For each case, the tool prints the time per test, the share of tests that fell
+///  back to exact arithmetic, and how many signs the plain double formula got wrong.
+///  Finally, a grid of points, which is full of co-circular quadruples, is
+///  triangulated to show the fallback rate in practice.
+/// </summary>
+
+#define THOR_PREDICATE_STATISTICS
+#include <Thor/Math/Predicates.hpp>
+#include <Thor/Math/Triangulation.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+	typedef std::chrono::steady_clock Clock;
+
+	double nanosecondsSince(Clock::time_point t_start, std::size_t t_count)
+	{
+		return std::chrono::duration<double, std::nano>(Clock::now() - t_start).count() / t_count;
+	}
+
+	double plainOrientation(sf::Vector2f t_a, sf::Vector2f t_b, sf::Vector2f t_c)
+	{
+		return (double(t_a.x) - t_c.x) * (double(t_b.y) - t_c.y) - (double(t_a.y) - t_c.y) * (double(t_b.x) - t_c.x);
+	}
+
+	double plainInCircle(sf::Vector2f t_a, sf::Vector2f t_b, sf::Vector2f t_c, sf::Vector2f t_d)
+	{
+		double adx = double(t_a.x) - t_d.x, ady = double(t_a.y) - t_d.y;
+		double bdx = double(t_b.x) - t_d.x, bdy = double(t_b.y) - t_d.y;
+		double cdx = double(t_c.x) - t_d.x, cdy = double(t_c.y) - t_d.y;
+		return (adx * adx + ady * ady) * (bdx * cdy - cdx * bdy)
+			+ (bdx * bdx + bdy * bdy) * (cdx * ady - adx * cdy)
+			+ (cdx * cdx + cdy * cdy) * (adx * bdy - bdx * ady);
+	}
+
+	int sign(double t_value)
+	{
+		return (t_value > 0.0) - (t_value < 0.0);
+	}
+
+	void resetStatistics()
+	{
+		thor::detail::PredicateStatistics& statistics = thor::detail::getPredicateStatistics();
+		statistics.orientationCalls = 0;
+		statistics.orientationExact = 0;
+		statistics.inCircleCalls = 0;
+		statistics.inCircleExact = 0;
+	}
+
+	// Times both predicates on the points, which are used three (orientation) or four (inCircle) at a time.
+	void measure(const std::string& t_name, const std::vector<sf::Vector2f>& t_points)
+	{
+		const std::size_t orientationTests = t_points.size() / 3;
+		const std::size_t inCircleTests = t_points.size() / 4;
+		const thor::detail::PredicateStatistics& statistics = thor::detail::getPredicateStatistics();
+		resetStatistics();
+
+		std::vector<int> exactSigns(orientationTests);
+		Clock::time_point start = Clock::now();
+		for (std::size_t i = 0; i < orientationTests; ++i)
+		{
+			exactSigns[i] = sign(thor::orientation(t_points[3 * i], t_points[3 * i + 1], t_points[3 * i + 2]));
+		}
+		double exactTime = nanosecondsSince(start, orientationTests);
+
+		std::size_t wrongSigns = 0;
+		start = Clock::now();
+		for (std::size_t i = 0; i < orientationTests; ++i)
+		{
+			wrongSigns += sign(plainOrientation(t_points[3 * i], t_points[3 * i + 1], t_points[3 * i + 2])) != exactSigns[i];
+		}
+		double plainTime = nanosecondsSince(start, orientationTests);
+
+		std::cout << t_name << ", orientation: " << exactTime << " ns exact, " << plainTime << " ns plain, "
+			<< 100.0 * statistics.orientationExact / orientationTests << "% fallbacks, "
+			<< wrongSigns << " of " << orientationTests << " plain signs wrong\n";
+
+		exactSigns.resize(inCircleTests);
+		start = Clock::now();
+		for (std::size_t i = 0; i < inCircleTests; ++i)
+		{
+			exactSigns[i] = sign(thor::inCircle(t_points[4 * i], t_points[4 * i + 1], t_points[4 * i + 2], t_points[4 * i + 3]));
+		}
+		exactTime = nanosecondsSince(start, inCircleTests);
+
+		wrongSigns = 0;
+		start = Clock::now();
+		for (std::size_t i = 0; i < inCircleTests; ++i)
+		{
+			wrongSigns += sign(plainInCircle(t_points[4 * i], t_points[4 * i + 1], t_points[4 * i + 2], t_points[4 * i + 3])) != exactSigns[i];
+		}
+		plainTime = nanosecondsSince(start, inCircleTests);
+
+		std::cout << t_name << ", inCircle:    " << exactTime << " ns exact, " << plainTime << " ns plain, "
+			<< 100.0 * statistics.inCircleExact / inCircleTests << "% fallbacks, "
+			<< wrongSigns << " of " << inCircleTests << " plain signs wrong\n";
+	}
+}
+
+////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+	std::size_t testCount = 1000000;
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		std::string option = argv[i];
+		if (option == "-n")
+		{
+			testCount = std::strtoul(argv[i + 1], nullptr, 10);
+		}
+		else
+		{
+			std::cerr << "Usage: PredicateBenchmark [-n <tests>]\n";
+			return 1;
+		}
+	}
+
+	std::mt19937 random(42);
+	std::uniform_real_distribution<float> coordinate(0.0f, 1000.0f);
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+	std::vector<sf::Vector2f> points(12 * testCount / 12);
+	for (sf::Vector2f& point : points)
+	{
+		point = sf::Vector2f(coordinate(random), coordinate(random));
+	}
+	measure("random", points);
+
+	// Integer points on a circle of radius 1105, which has many of them.
+	const int radius = 1105;
+	std::vector<sf::Vector2f> circle;
+	for (int x = -radius; x <= radius; ++x)
+	{
+		int y = static_cast<int>(std::lround(std::sqrt(double(radius) * radius - double(x) * x)));
+		if (x * x + y * y == radius * radius)
+		{
+			circle.push_back(sf::Vector2f(static_cast<float>(x), static_cast<float>(y)));
+			circle.push_back(sf::Vector2f(static_cast<float>(x), static_cast<float>(-y)));
+		}
+	}
+
+	// Each group of 12 points lies exactly on one line or one circle; in every other group, one point is moved by one ulp.
+	for (std::size_t i = 0; i + 12 <= points.size(); i += 12)
+	{
+		sf::Vector2f origin(std::floor(coordinate(random)), std::floor(coordinate(random)));
+		sf::Vector2f direction(static_cast<float>(random() % 17) - 8.0f, static_cast<float>(random() % 17) - 8.0f);
+		for (std::size_t k = 0; k < 12; ++k)
+		{
+			points[i + k] = (i / 12 % 2 == 0)
+				? origin + direction * static_cast<float>(static_cast<int>(random() % 101) - 50)
+				: origin + circle[random() % circle.size()];
+		}
+
+		if (i / 24 % 2 == 0)
+		{
+			sf::Vector2f& moved = points[i + random() % 12];
+			moved.x = std::nextafter(moved.x, 2000.0f);
+		}
+	}
+	measure("degenerate", points);
+
+	std::vector<sf::Vector2f> grid;
+	for (int y = 0; y < 300; ++y)
+	{
+		for (int x = 0; x < 300; ++x)
+		{
+			grid.push_back(sf::Vector2f(static_cast<float>(x), static_cast<float>(y)));
+		}
+	}
+
+	resetStatistics();
+	std::vector<thor::Triangle<const sf::Vector2f>> triangles;
+	Clock::time_point start = Clock::now();
+	thor::triangulate(grid.cbegin(), grid.cend(), std::back_inserter(triangles));
+	double time = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+	const thor::detail::PredicateStatistics& statistics = thor::detail::getPredicateStatistics();
+	std::cout << "grid triangulation: " << grid.size() << " points, " << triangles.size() << " triangles in " << time << " ms, "
+		<< statistics.orientationExact << " of " << statistics.orientationCalls << " orientation and "
+		<< statistics.inCircleExact << " of " << statistics.inCircleCalls << " inCircle tests exact\n";
+	return 0;
+}
@@ -0,0 +1,117 @@
+/// <summary>
+/// @brief Measures recording, sorting and submitting render commands without a GPU.
+///
+/// Usage:
+///		RenderCommandBenchmark [-d <draws per frame>] [-t <textures>] [-n <frames>]
+/// Every frame records quads on random layers with random textures and blend modes,
+///  sorts them and submits them to the null backend, which reads every vertex.
+///  The times are averaged over all frames after the first, which warms up the
+///  frame allocator.
+/// </summary>
+
+#include "../RenderCommandBuffer.h"
+#include "../RenderBackend.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+	typedef std::chrono::steady_clock Clock;
+
+	double millisecondsSince(Clock::time_point t_start)
+	{
+		return std::chrono::duration<double, std::milli>(Clock::now() - t_start).count();
+	}
+}
+
+////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+	std::size_t drawCount = 10000;
+	std::size_t textureCount = 8;
+	int frames = 100;
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		std::string option = argv[i];
+		if (option == "-d")
+		{
+			drawCount = std::strtoul(argv[i + 1], nullptr, 10);
+		}
+		else if (option == "-t")
+		{
+			textureCount = std::strtoul(argv[i + 1], nullptr, 10);
+		}
+		else if (option == "-n")
+		{
+			frames = std::atoi(argv[i + 1]);
+		}
+		else
+		{
+			std::cerr << "Usage: RenderCommandBenchmark [-d <draws per frame>] [-t <textures>] [-n <frames>]\n";
+			return 1;
+		}
+	}
+
+	// The textures are only used as identities, they are never uploaded.
+	std::vector<sf::Texture> textures(textureCount);
+	const sf::BlendMode blendModes[] = { sf::BlendAlpha, sf::BlendAdd };
+
+	std::mt19937 random(42);
+	RenderCommandBuffer commands;
+	NullRenderBackend backend;
+
+	double recordTime = 0;
+	double sortTime = 0;
+	double submitTime = 0;
+	for (int frame = 0; frame <= frames; ++frame)
+	{
+		commands.clear();
+
+		Clock::time_point start = Clock::now();
+		for (std::size_t i = 0; i < drawCount; ++i)
+		{
+			float x = static_cast<float>(random() % 800);
+			float y = static_cast<float>(random() % 600);
+			sf::Vertex* quad = commands.allocateVertices(6);
+			quad[0].position = sf::Vector2f(x, y);
+			quad[1].position = sf::Vector2f(x + 16, y);
+			quad[2].position = sf::Vector2f(x, y + 16);
+			quad[3].position = sf::Vector2f(x + 16, y);
+			quad[4].position = sf::Vector2f(x + 16, y + 16);
+			quad[5].position = sf::Vector2f(x, y + 16);
+			commands.draw(static_cast<RenderLayer>(random() % 3), quad, 6, sf::Triangles,
+				&textures[random() % textureCount], blendModes[random() % 2]);
+		}
+		double recorded = millisecondsSince(start);
+
+		start = Clock::now();
+		commands.sort();
+		double sorted = millisecondsSince(start);
+
+		start = Clock::now();
+		backend.submit(commands);
+		double submitted = millisecondsSince(start);
+
+		if (frame > 0)
+		{
+			recordTime += recorded;
+			sortTime += sorted;
+			submitTime += submitted;
+		}
+	}
+
+	std::cout << drawCount << " draws, " << textureCount << " textures, " << frames << " frames\n"
+		<< "record: " << recordTime / frames << " ms/frame\n"
+		<< "sort:   " << sortTime / frames << " ms/frame\n"
+		<< "submit: " << submitTime / frames << " ms/frame\n"
+		<< "state changes: " << backend.getStateChangeCount() << " of " << backend.getDrawCallCount() << " draws\n"
+		<< "frame memory: " << commands.getArena().getBytesUsed() / 1024 << " KiB in "
+		<< commands.getArena().getChunkAllocationCount() << " heap allocations"
+		<< " (checksum " << backend.getChecksum() << ")\n";
+	return 0;
+}
@@ -0,0 +1,124 @@
+/// <summary>
+/// @brief Compares resource lookups in thor::ResourceHolder with ordered and hashed storage.
+///
+/// Usage:
+///		ResourceLookupBenchmark [-r <resources>] [-l <lookups>]
+/// Both holders are filled with the same string IDs, shaped like asset paths, and then
+///  look up the same random sequence of IDs with operator[]. The hashed holder is
+///  measured twice: with std::string keys, and with C string keys, which it looks up
+///  without building a temporary std::string. The sums of the looked up values must
+///  agree, which serves as a sanity check.
+/// </summary>
+
+#include <Thor/Resources.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+	typedef std::chrono::steady_clock Clock;
+
+	double millisecondsSince(Clock::time_point t_start)
+	{
+		return std::chrono::duration<double, std::milli>(Clock::now() - t_start).count();
+	}
+
+	struct Asset
+	{
+		std::size_t value;
+	};
+
+	thor::ResourceLoader<Asset> assetLoader(std::size_t t_value)
+	{
+		return thor::ResourceLoader<Asset>([t_value] { return std::unique_ptr<Asset>(new Asset{ t_value }); },
+			std::to_string(t_value));
+	}
+
+	template <typename Holder>
+	void fill(Holder& t_holder, const std::vector<std::string>& t_ids)
+	{
+		for (std::size_t i = 0; i < t_ids.size(); ++i)
+		{
+			t_holder.acquire(t_ids[i], assetLoader(i));
+		}
+	}
+
+	// Looks up the keys in order and returns the sum of the values, so the lookups cannot be optimised away.
+	template <typename Holder, typename Key>
+	std::size_t lookUp(Holder& t_holder, const std::vector<Key>& t_keys, double& t_milliseconds)
+	{
+		std::size_t sum = 0;
+		Clock::time_point start = Clock::now();
+		for (const Key& key : t_keys)
+		{
+			sum += t_holder[key].value;
+		}
+		t_milliseconds = millisecondsSince(start);
+		return sum;
+	}
+}
+
+////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+	std::size_t resourceCount = 10000;
+	std::size_t lookupCount = 1000000;
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		std::string option = argv[i];
+		if (option == "-r")
+		{
+			resourceCount = std::strtoul(argv[i + 1], nullptr, 10);
+		}
+		else if (option == "-l")
+		{
+			lookupCount = std::strtoul(argv[i + 1], nullptr, 10);
+		}
+	}
+
+	std::vector<std::string> ids;
+	for (std::size_t i = 0; i < resourceCount; ++i)
+	{
+		char id[64];
+		std::snprintf(id, sizeof(id), "resources/textures/asset_%05u.png", static_cast<unsigned>(i));
+		ids.push_back(id);
+	}
+
+	// The same random sequence for all variants; the keys refer to the strings in ids.
+	std::mt19937 random(1);
+	std::uniform_int_distribution<std::size_t> pick(0, resourceCount - 1);
+	std::vector<std::string> stringKeys;
+	std::vector<const char*> cStringKeys;
+	for (std::size_t i = 0; i < lookupCount; ++i)
+	{
+		std::size_t index = pick(random);
+		stringKeys.push_back(ids[index]);
+		cStringKeys.push_back(ids[index].c_str());
+	}
+
+	thor::ResourceHolder<Asset, std::string> ordered;
+	thor::ResourceHolder<Asset, std::string, thor::Resources::CentralOwner, thor::Resources::HashedStorage> hashed;
+	fill(ordered, ids);
+	fill(hashed, ids);
+
+	double orderedTime = 0.0;
+	double hashedTime = 0.0;
+	double hashedCStringTime = 0.0;
+	std::size_t orderedSum = lookUp(ordered, stringKeys, orderedTime);
+	std::size_t hashedSum = lookUp(hashed, stringKeys, hashedTime);
+	std::size_t hashedCStringSum = lookUp(hashed, cStringKeys, hashedCStringTime);
+
+	std::cout << resourceCount << " resources, " << lookupCount << " lookups\n"
+		<< "ordered storage:               " << orderedTime << " ms\n"
+		<< "hashed storage:                " << hashedTime << " ms\n"
+		<< "hashed storage, C string keys: " << hashedCStringTime << " ms\n"
+		<< (orderedSum == hashedSum && hashedSum == hashedCStringSum ? "results agree" : "RESULTS DIFFER") << "\n";
+	return orderedSum == hashedSum && hashedSum == hashedCStringSum ? 0 : 1;
+}
@@ -0,0 +1,233 @@
+/// <summary>
+/// @brief Renders test scenes with the software rasterizer, compares them to golden images and measures the fill cost.
+///
+/// Usage:
+///		SoftwareRenderTest <golden directory> [-update] [-t <threads>] [-n <frames>]
+/// The scenes are built from the game's own ParticleSystem and SpriteBatch, with
+///  procedurally generated textures, so no GPU and no resource files are needed.
+///  Each scene is compared to <golden directory>/<scene>.png, allowing a small difference
+///  per channel; -update writes the golden images instead. The exit code is 1 if any
+///  scene differs.
+/// Build it from this file and the game's ParticleSystem, SpriteBatch, SoftwareRenderBackend,
+///  RenderCommandBuffer and TimerWheel sources, linked against SFML and Thor.
+/// The golden images are committed in tools/golden, so from the repository root:
+///		SoftwareRenderTest tools/golden
+///  checks the rasterizer, SpriteBatch and the particle quads. After an intended change
+///  to their output, run it with -update and commit the new images with the change.
+/// </summary>
+
+#include "../ParticleSystem.h"
+#include "../SpriteBatch.h"
+#include "../SoftwareRenderBackend.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <string>
+
+namespace
+{
+	typedef std::chrono::steady_clock Clock;
+
+	double millisecondsSince(Clock::time_point t_start)
+	{
+		return std::chrono::duration<double, std::milli>(Clock::now() - t_start).count();
+	}
+
+	const unsigned WIDTH = 800;
+	const unsigned HEIGHT = 600;
+
+	// Largest channel difference that still counts as equal. Compilers and math libraries round sin/cos
+	//  and interpolated colours differently in the last bit, which shifts a channel by a step or two.
+	const std::uint8_t CHANNEL_TOLERANCE = 2;
+
+	// A soft white disc, similar to the smoke particle.
+	sf::Image createDiscImage(unsigned t_size)
+	{
+		sf::Image image;
+		image.create(t_size, t_size, sf::Color::Transparent);
+		float radius = t_size / 2.0f;
+		for (unsigned y = 0; y < t_size; ++y)
+		{
+			for (unsigned x = 0; x < t_size; ++x)
+			{
+				float distance = std::hypot(x + 0.5f - radius, y + 0.5f - radius) / radius;
+				float alpha = distance < 1.0f ? 1.0f - distance : 0.0f;
+				image.setPixel(x, y, sf::Color(255, 255, 255, static_cast<sf::Uint8>(alpha * 255)));
+			}
+		}
+		return image;
+	}
+
+	struct Scene
+	{
+		std::string name;
+		std::function<void(RenderCommandBuffer&)> record;
+	};
+}
+
+////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+	if (argc < 2)
+	{
+		std::cerr << "Usage: SoftwareRenderTest <golden directory> [-update] [-t <threads>] [-n <frames>]\n";
+		return 1;
+	}
+
+	std::string goldenDirectory = argv[1];
+	bool update = false;
+	unsigned threads = 1;
+	int frames = 50;
+	for (int i = 2; i < argc; ++i)
+	{
+		std::string option = argv[i];
+		if (option == "-update")
+		{
+			update = true;
+		}
+		else if (option == "-t" && i + 1 < argc)
+		{
+			threads = static_cast<unsigned>(std::atoi(argv[++i]));
+		}
+		else if (option == "-n" && i + 1 < argc)
+		{
+			frames = std::atoi(argv[++i]);
+		}
+	}
+
+	// The textures are never uploaded; the backend samples the images registered for them.
+	sf::Image discImage = createDiscImage(32);
+	sf::Image whiteImage;
+	whiteImage.create(4, 4, sf::Color::White);
+	sf::Texture discTexture;
+	sf::Texture whiteTexture;
+
+	SoftwareRenderBackend backend(WIDTH, HEIGHT);
+	backend.setTexture(&discTexture, discImage);
+	backend.setTexture(&whiteTexture, whiteImage);
+	backend.setThreadCount(threads);
+
+	// Thor's random distributions depend on the standard library, so the particles are emitted in fixed
+	//  patterns instead; otherwise the golden image would only match one platform.
+	ParticleSystem particles;
+	particles.initParticleSystem(discTexture, sf::IntRect(0, 0, 32, 32));
+	particles.addAffector([](thor::Particle& t_particle, sf::Time t_dt)
+	{
+		t_particle.scale += sf::Vector2f(1.5f, 1.5f) * t_dt.asSeconds();
+	});
+	for (int i = 0; i < 8; ++i)
+	{
+		sf::Vector2f origin(100.0f + i * 80.0f, 200.0f + (i % 3) * 100.0f);
+		int burst = 0;
+		particles.addEmitter([origin, burst](thor::EmissionInterface& t_system, sf::Time) mutable
+		{
+			for (int j = 0; j < 6; ++j)
+			{
+				float angle = (burst * 20.0f + j * 60.0f) * 3.14159265f / 180.0f;
+				thor::Particle particle(sf::milliseconds(450));
+				particle.position = origin;
+				particle.velocity = sf::Vector2f(std::cos(angle), std::sin(angle)) * 150.0f;
+				particle.rotation = burst * 15.0f;
+				particle.color = sf::Color(255, static_cast<sf::Uint8>(140 + j * 20), 64, 200);
+				t_system.emitParticle(particle);
+			}
+			++burst;
+		}, sf::milliseconds(40));
+		for (int step = 0; step < 5; ++step)
+		{
+			particles.update(10.0);
+		}
+	}
+
+	SpriteBatch batch;
+	batch.setWhitePixel(&whiteTexture, sf::Vector2f(2.0f, 2.0f));
+
+	Scene scenes[] = {
+		{ "particles", [&](RenderCommandBuffer& t_commands)
+		{
+			particles.record(t_commands, RenderLayer::Effects);
+		} },
+		{ "arrows", [&](RenderCommandBuffer& t_commands)
+		{
+			for (int i = 0; i < 24; ++i)
+			{
+				float angle = i * 15.0f * 3.14159265f / 180.0f;
+				thor::Arrow arrow(sf::Vector2f(400, 300), sf::Vector2f(std::cos(angle), std::sin(angle)) * (60.0f + i * 8.0f),
+					sf::Color(255, static_cast<sf::Uint8>(i * 10), 0, 200), 1.0f + i % 4);
+				batch.draw(arrow);
+			}
+			// A zero vector is drawn as a circle.
+			batch.draw(thor::Arrow(sf::Vector2f(100, 100), sf::Vector2f()));
+
+			sf::CircleShape circle(40.0f);
+			circle.setPosition(600, 80);
+			circle.setFillColor(sf::Color(0, 128, 255, 160));
+			batch.draw(circle);
+
+			sf::RectangleShape rectangle(sf::Vector2f(120, 30));
+			rectangle.setPosition(80, 500);
+			rectangle.setRotation(20);
+			batch.draw(rectangle);
+
+			sf::Sprite sprite(discTexture);
+			sprite.setTextureRect(sf::IntRect(0, 0, 32, 32));
+			sprite.setPosition(650, 450);
+			sprite.setScale(3, 3);
+			batch.draw(sprite, sf::BlendAdd);
+
+			batch.record(t_commands, RenderLayer::World);
+		} }
+	};
+
+	bool passed = true;
+	RenderCommandBuffer commands;
+	for (Scene& scene : scenes)
+	{
+		commands.clear();
+		scene.record(commands);
+		commands.sort();
+
+		backend.clear();
+		backend.submit(commands);
+		sf::Image image = backend.copyToImage();
+
+		std::string goldenFile = goldenDirectory + "/" + scene.name + ".png";
+		if (update)
+		{
+			if (!image.saveToFile(goldenFile))
+			{
+				std::cerr << "Cannot write " << goldenFile << "\n";
+				return 1;
+			}
+			std::cout << scene.name << ": written to " << goldenFile << "\n";
+		}
+		else
+		{
+			sf::Image golden;
+			if (!golden.loadFromFile(goldenFile))
+			{
+				std::cerr << "Cannot load " << goldenFile << "\n";
+				return 1;
+			}
+			std::size_t different = SoftwareRenderBackend::countDifferentPixels(image, golden, CHANNEL_TOLERANCE);
+			std::cout << scene.name << ": " << (different == 0 ? "passed" : "FAILED") << ", " << different << " pixels differ\n";
+			passed = passed && different == 0;
+		}
+
+		Clock::time_point start = Clock::now();
+		for (int frame = 0; frame < frames; ++frame)
+		{
+			backend.clear();
+			backend.submit(commands);
+		}
+		double frameTime = millisecondsSince(start) / frames;
+		std::cout << "  " << frameTime << " ms per frame, " << backend.getFilledPixelCount() << " pixels filled, "
+			<< backend.getFilledPixelCount() / frameTime / 1000.0 << " Mpixels/s on " << threads << " threads\n";
+	}
+
+	return passed ? 0 : 1;
+}
@@ -0,0 +1,214 @@
+/// <summary>
+/// @brief Measures Thor's Delaunay triangulation on random points and on a large polygon.
+///
+/// Usage:
+///		TriangulationBenchmark [-p <points>] [-v <polygon vertices>] [-n <runs>] [-t <threads>]
+/// The points are uniform in a square; the polygon is a star with jittered radii,
+///  so most of its edges have to be enforced as constraints. The times are the
+///  best of all runs. A triangulation of n points in general position has
+///  2n - 2 - h triangles, h being the number of points on the convex hull, and a
+///  simple polygon with n vertices n - 2 triangles, which serves as a sanity check.
+/// The points are then triangulated with thor::triangulateParallel() on 1, 2, 4...
+///  up to the given number of threads (all hardware threads by default), which
+///  must give the same number of triangles.
+/// Heap allocations are counted by replacing the global operator new, and reported
+///  for both triangulations with and without a thor::MemoryArena.
+/// </summary>
+
+#include <Thor/Math/Triangulation.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	typedef std::chrono::steady_clock Clock;
+
+	double millisecondsSince(Clock::time_point t_start)
+	{
+		return std::chrono::duration<double, std::milli>(Clock::now() - t_start).count();
+	}
+
+	typedef thor::Triangle<const sf::Vector2f> Triangle;
+
+	std::size_t g_heapAllocations = 0;
+
+	// Reports the heap and arena allocations of one call of t_triangulate.
+	template <typename Function>
+	void reportAllocations(const char* t_name, thor::MemoryArena& t_arena, Function t_triangulate)
+	{
+		std::size_t heapBefore = g_heapAllocations;
+		t_triangulate(nullptr);
+		std::size_t heapAllocations = g_heapAllocations - heapBefore;
+
+		// Warm up the arena, so that the measured run shows the steady state
+		t_triangulate(&t_arena);
+		t_arena.reset();
+		std::size_t chunksBefore = t_arena.getChunkAllocationCount();
+		heapBefore = g_heapAllocations;
+		t_triangulate(&t_arena);
+
+		std::cout << t_name << " allocations: " << heapAllocations << " on the heap; with an arena "
+			<< g_heapAllocations - heapBefore << " on the heap, " << t_arena.getAllocationCount() << " in the arena ("
+			<< t_arena.getBytesUsed() / 1024 << " KB, " << t_arena.getChunkAllocationCount() - chunksBefore << " new chunks)\n";
+		t_arena.reset();
+	}
+}
+
+////////////////////////////////////////////////////////////
+void* operator new(std::size_t t_size)
+{
+	++g_heapAllocations;
+	if (void* memory = std::malloc(t_size != 0 ? t_size : 1))
+	{
+		return memory;
+	}
+	throw std::bad_alloc();
+}
+
+////////////////////////////////////////////////////////////
+void operator delete(void* t_memory) noexcept
+{
+	std::free(t_memory);
+}
+
+////////////////////////////////////////////////////////////
+void operator delete(void* t_memory, std::size_t) noexcept
+{
+	std::free(t_memory);
+}
+
+////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+	std::size_t pointCount = 100000;
+	std::size_t polygonVertexCount = 10000;
+	int runs = 5;
+	unsigned int maxThreads = std::max(1u, std::thread::hardware_concurrency());
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		std::string option = argv[i];
+		if (option == "-p")
+		{
+			pointCount = std::strtoul(argv[i + 1], nullptr, 10);
+		}
+		else if (option == "-v")
+		{
+			polygonVertexCount = std::strtoul(argv[i + 1], nullptr, 10);
+		}
+		else if (option == "-n")
+		{
+			runs = std::max(1, std::atoi(argv[i + 1]));
+		}
+		else if (option == "-t")
+		{
+			maxThreads = std::max(1, std::atoi(argv[i + 1]));
+		}
+		else
+		{
+			std::cerr << "Usage: TriangulationBenchmark [-p <points>] [-v <polygon vertices>] [-n <runs>] [-t <threads>]\n";
+			return 1;
+		}
+	}
+
+	std::mt19937 random(42);
+	std::uniform_real_distribution<float> coordinate(0.0f, 1000.0f);
+	std::uniform_real_distribution<float> radius(200.0f, 500.0f);
+
+	std::vector<sf::Vector2f> points(pointCount);
+	for (sf::Vector2f& point : points)
+	{
+		point = sf::Vector2f(coordinate(random), coordinate(random));
+	}
+
+	std::vector<sf::Vector2f> polygon(polygonVertexCount);
+	for (std::size_t i = 0; i < polygonVertexCount; ++i)
+	{
+		float angle = 2.0f * 3.14159265f * i / polygonVertexCount;
+		float length = (i % 2 == 0) ? radius(random) : 100.0f;
+		polygon[i] = sf::Vector2f(500.0f + length * std::cos(angle), 500.0f + length * std::sin(angle));
+	}
+
+	std::vector<Triangle> triangles;
+	double pointTime = std::numeric_limits<double>::max();
+	double polygonTime = std::numeric_limits<double>::max();
+	std::size_t pointTriangleCount = 0;
+	std::size_t polygonTriangleCount = 0;
+	for (int run = 0; run < runs; ++run)
+	{
+		triangles.clear();
+		Clock::time_point start = Clock::now();
+		thor::triangulate(points.cbegin(), points.cend(), std::back_inserter(triangles));
+		pointTime = std::min(pointTime, millisecondsSince(start));
+		pointTriangleCount = triangles.size();
+
+		triangles.clear();
+		start = Clock::now();
+		thor::triangulatePolygon(polygon.cbegin(), polygon.cend(), std::back_inserter(triangles));
+		polygonTime = std::min(polygonTime, millisecondsSince(start));
+		polygonTriangleCount = triangles.size();
+	}
+
+	std::cout << "points:  " << pointCount << " -> " << pointTriangleCount << " triangles in " << pointTime << " ms ("
+		<< pointCount / pointTime / 1000.0 << " Mpoints/s)\n"
+		<< "polygon: " << polygonVertexCount << " -> " << polygonTriangleCount << " triangles in " << polygonTime << " ms"
+		<< (polygonTriangleCount + 2 == polygonVertexCount ? "" : " (WRONG COUNT)") << "\n";
+
+	// The output vector is reserved, so that only the triangulation itself allocates
+	triangles.clear();
+	triangles.reserve(std::max(2 * pointCount, polygonVertexCount));
+	thor::MemoryArena arena;
+	reportAllocations("points", arena, [&](thor::MemoryArena* t_arena)
+	{
+		triangles.clear();
+		if (t_arena)
+		{
+			thor::triangulate(*t_arena, points.cbegin(), points.cend(), std::back_inserter(triangles));
+		}
+		else
+		{
+			thor::triangulate(points.cbegin(), points.cend(), std::back_inserter(triangles));
+		}
+	});
+	reportAllocations("polygon", arena, [&](thor::MemoryArena* t_arena)
+	{
+		triangles.clear();
+		if (t_arena)
+		{
+			thor::triangulatePolygon(*t_arena, polygon.cbegin(), polygon.cend(), std::back_inserter(triangles));
+		}
+		else
+		{
+			thor::triangulatePolygon(polygon.cbegin(), polygon.cend(), std::back_inserter(triangles));
+		}
+	});
+
+	for (unsigned int threads = 1; ; threads = std::min(2 * threads, maxThreads))
+	{
+		double parallelTime = std::numeric_limits<double>::max();
+		for (int run = 0; run < runs; ++run)
+		{
+			triangles.clear();
+			Clock::time_point start = Clock::now();
+			thor::triangulateParallel(points.cbegin(), points.cend(), std::back_inserter(triangles), threads);
+			parallelTime = std::min(parallelTime, millisecondsSince(start));
+		}
+
+		std::cout << "parallel, " << threads << " threads: " << parallelTime << " ms, speedup " << pointTime / parallelTime
+			<< (triangles.size() == pointTriangleCount ? "" : " (WRONG COUNT)") << "\n";
+
+		if (threads == maxThreads)
+			break;
+	}
+	return 0;
+}